@@ -7,6 +7,10 @@
 #include <queue>
 #include "CollisionDetector.h"
 #include "GameState.h"
+#include "HitEventQueue.h"
+#include "StateHash.h"
+#include "Profiler.h"
+#include "Logger.h"
 class AITank
 {
 public:
@@ -15,9 +19,9 @@ public:
 	/// Initialises steering behaviour to seek (player) mode, sets the AI tank position and
 	///  initialises the steering vector to (0,0) meaning zero force magnitude.
 	/// </summary>
-	/// <param name="texture">A reference to the sprite sheet texture</param>
+	/// <param name="texture">The sprite sheet texture, or nullptr when headless</param>
 	///< param name="wallSprites">A reference to the container of wall sprites</param>
-	AITank(sf::Texture const & texture, std::vector<sf::Sprite> & wallSprites);
+	AITank(sf::Texture const * texture, std::vector<sf::Sprite> & wallSprites);
 
 	/// <summary>
 	/// @brief Steers the AI tank towards the player tank avoiding obstacles along the way.
@@ -33,11 +37,18 @@ public:
 	
 
 	/// <summary>
-	/// @brief Draws the tank base and turret.
-	///
+	/// @brief Copies the previous and current base and turret, the steering rays and the
+	///  obstacles, into a render snapshot.
+	/// The obstacles never change after init(), so they are only copied into a snapshot
+	///  that does not hold them yet.
 	/// </summary>
-	/// <param name="window">The SFML Render window</param>
-	void render(sf::RenderWindow & window);
+	void snapshot(TankSnapshot & t_tank, SteeringSnapshot & t_steering) const;
+
+	/// <summary>
+	/// @brief Remembers the current base and turret transforms, as the start of the next tick
+	///  for render interpolation. Called at the start of every simulation tick.
+	/// </summary>
+	void storePreviousState();
 
 	/// <summary>
 	/// @brief Initialises the obstacle container and sets the tank base/turret sprites to the specified position and scale.
@@ -52,15 +63,31 @@ public:
 		AI_ID_SEEK_SHOOT_AT_PLAYER
 	};
 
+	/// <summary>
+	/// @brief Smooths a steering output with an exponential moving average of the previous outputs.
+	/// </summary>
+	/// <param name="input">The new output</param>
+	/// <param name="alpha">How much of the previous average to keep, 0 to 1</param>
 	sf::Vector2f filterOutput(sf::Vector2f input, float alpha);
+
+	/// <summary>
+	/// @brief Adds the position, steering and health of the tank to a state hash.
+	/// </summary>
+	void hash(StateHash & t_hash) const;
 	bool collidesWithPlayer(Tank const& playerTank) const;
 	const sf::Sprite& getBase() const;
 	sf::Sprite& getBase();
+	const sf::Sprite& getTurret() const;
 	// A sprite for the tank base.
 	sf::Sprite m_tankBase;
-	void applyDamage(int t_damageAmount);
 
-	void checkProjectileCollision(std::vector<Projectile>& projectiles, GameState const& gameState);
+	/// <summary>
+	/// @brief Applies the damage of every hit on this tank recorded this tick, in one batch.
+	/// Hits on other targets are ignored.
+	/// </summary>
+	/// <param name="t_hits">The hits recorded this tick</param>
+	void applyDamage(HitEventQueue const & t_hits);
+
 	//void setGameState(GameState newState);
 	//GameState getGameState() const;
 	//GameState m_currentGameState; // Store the current game state
@@ -77,8 +104,8 @@ private:
 
 	sf::Vector2f findMostThreateningObstacle();
 
-	// A reference to the sprite sheet texture.
-	sf::Texture const & m_texture;
+	// The sprite sheet texture, nullptr when headless.
+	sf::Texture const * m_texture;
 
 
 
@@ -100,11 +127,7 @@ private:
 
 	// The ahead vector.
 	sf::Vector2f m_ahead;
-	sf::RectangleShape m_aheadVector;
-
-	sf::RectangleShape m_aheadLeftVector;
 
-	sf::RectangleShape m_aheadRightVector;
 	// The half-ahead vector.
 	sf::Vector2f m_halfAhead;
 
@@ -116,6 +139,13 @@ private:
 
 	sf::Vector2f m_projectedVelocity;
 
+	// The last output of filterOutput(), per tank so runs can be replayed exactly.
+	sf::Vector2f m_filteredOutput{ 0.0f, 0.0f };
+
+	// The base and turret transforms at the start of the last tick.
+	sf::Transformable m_previousBase;
+	sf::Transformable m_previousTurret;
+
 	// The maximum see ahead range.
 	static float constexpr MAX_SEE_AHEAD{ 150.0f };
 
@@ -128,6 +158,13 @@ private:
 	// The maximum speed for this tank.
 	float MAX_SPEED = 50.0f;
 
+	// Degrees per second the tank turns towards its velocity.
+	static double constexpr ROTATION_SPEED{ 60.0 };
+
+	// The steering forces above are per step of this many milliseconds (1/60 s, the step they
+	//  were tuned at); update() scales them by dt / STEERING_STEP_MS.
+	static double constexpr STEERING_STEP_MS{ 1000.0 / 60.0 };
+
 	// A container of circles that represent the obstacles to avoid.
 	std::vector<sf::CircleShape> m_obstacles;
 
@@ -138,9 +175,6 @@ private:
 		RETREAT
 	} m_aiBehaviour;
 
-	sf::Text healthText;
-	// The font for this HUD.
-	sf::Font m_arialFont;
 	sf::CircleShape* m_mostThreatening{ nullptr };
 	int m_health = 5;  // AI tank's health
 	//GameState getGameState() const;
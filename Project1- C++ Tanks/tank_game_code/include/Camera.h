@@ -0,0 +1,60 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+/// <summary>
+/// @brief A camera that follows a target around a world larger than the screen.
+///
+/// The camera owns the sf::View the world is drawn with, and keeps it inside the world bounds
+///  so nothing beyond the edge of the map is ever shown. Renderers ask it whether a bounding box
+///  is visible before transforming or submitting anything, so the cost of a frame depends on what
+///  is on screen rather than on the size of the map.
+/// Example usage:
+///		camera.follow(tank.getPosition());
+///		window.setView(camera.view());
+///		if (camera.isVisible(sprite.getGlobalBounds())) { window.draw(sprite); }
+/// </summary>
+class Camera
+{
+public:
+	/// <summary>
+	/// @brief Creates a camera looking at the top left corner of the world.
+	/// </summary>
+	/// <param name="t_size">The size of the visible area in world units, usually the window size</param>
+	/// <param name="t_worldBounds">The area the camera is kept inside</param>
+	Camera(sf::Vector2f t_size, sf::FloatRect const & t_worldBounds);
+
+	/// <summary>
+	/// @brief Changes the area the camera is kept inside, e.g. when a new level is loaded.
+	/// </summary>
+	void setWorldBounds(sf::FloatRect const & t_worldBounds);
+
+	/// <summary>
+	/// @brief Centres the view on the target, as far as the world bounds allow.
+	/// If the world is smaller than the view along an axis, the world is centred along that axis instead.
+	/// </summary>
+	/// <param name="t_target">The world position to look at</param>
+	void follow(sf::Vector2f t_target);
+
+	/// <summary>
+	/// @brief Returns the view to draw the world with.
+	/// </summary>
+	sf::View const & view() const;
+
+	/// <summary>
+	/// @brief Returns the world space rectangle currently visible.
+	/// </summary>
+	sf::FloatRect const & visibleArea() const;
+
+	/// <summary>
+	/// @brief Returns true if any part of the given world space bounds is visible.
+	/// </summary>
+	bool isVisible(sf::FloatRect const & t_bounds) const;
+
+private:
+	sf::View m_view;
+	sf::FloatRect m_worldBounds;
+
+	// Cached from m_view, which is never rotated or zoomed.
+	sf::FloatRect m_visibleArea;
+};
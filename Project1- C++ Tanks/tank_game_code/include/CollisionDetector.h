@@ -1,6 +1,9 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
 #include "OrientedBoundingBox.h"
 
 /// <summary>
@@ -20,5 +23,22 @@ class CollisionDetector
 {
 public:
 	bool static collision(const sf::Sprite& object1, const sf::Sprite& object2);
+	bool static collision(const sf::Sprite& object1, const StaticCollider& object2); // As above, but reuses the precomputed data of a static object
+	// Sweeps a circle of the given radius from start to end against a static OBB.
+	// On a hit, timeOfImpact is set to the fraction (0..1) of the path travelled before first contact.
+	bool static sweep(const sf::Vector2f& start, const sf::Vector2f& end, float radius, const StaticCollider& object, float& timeOfImpact);
+	// Runs the same SAT test as collision() between one OBB and boxes [first, last) of a batch, 8 (AVX) or 4 (SSE) boxes at a time.
+	// outMask[i] is set to 1 if the OBB overlaps box first + i, otherwise 0.
+	void static collideBatch(const OrientedBoundingBox& obb, const ObbBatch& batch, int first, int last, std::uint8_t* outMask);
+	void static collideBatch(const OrientedBoundingBox& obb, const ObbBatch& batch, std::vector<std::uint8_t>& outMask); // Tests every box in the batch
+
+	// Bakes the collision mask of a whole texture from the image it was created from, so pixelPerfectTest() never reads the texture back.
+	// Call at load time. The mask is cached in sourceFile + ".mask" and memory mapped on later runs;
+	//  the cache is rebuilt when the source file changes. Pass an empty sourceFile to skip the cache.
+	void static loadMasks(const sf::Texture& texture, const sf::Image& image, const std::string& sourceFile, sf::Uint8 alphaLimit = 0);
+	// As above, but a null texture bakes the mask used by sprites that have no texture, only a texture rect into the image.
+	// Headless runs use these, as creating a texture needs an OpenGL context.
+	void static loadMasks(const sf::Texture* texture, const sf::Image& image, const std::string& sourceFile, sf::Uint8 alphaLimit = 0);
+
 	bool static pixelPerfectTest(const sf::Sprite& sprite1, const sf::Sprite& sprite2, sf::Uint8 alphaLimit = 0);
 };
@@ -0,0 +1,68 @@
+#pragma once
+
+// If VS Debug build is enabled, debug shapes can be recorded and drawn.
+//  In any other build every DebugDraw function is an empty inline function and
+//  isEnabled() is a constant false, so calls to it and code guarded by it compile to nothing.
+#ifdef _DEBUG
+#define DEBUG_DRAW
+#endif // _DEBUG
+
+#include <SFML/Graphics.hpp>
+
+/// <summary>
+/// @brief A debug draw layer for visualising things like AI steering.
+///
+/// Lines and circles are recorded from anywhere during the frame into a single vertex
+///  batch, and drawn with one draw call by render(), which also empties the batch.
+/// Recording can be toggled at runtime; while it is off, recording costs one branch.
+/// Example usage:
+///		if (DebugDraw::isEnabled())
+///		{
+///			DebugDraw::line(position, ahead, sf::Color::Red);
+///		}
+///		...
+///		DebugDraw::render(window);
+/// </summary>
+class DebugDraw
+{
+public:
+#ifdef DEBUG_DRAW
+	/// <summary>
+	/// @brief Records a line segment in world space.
+	/// </summary>
+	static void line(sf::Vector2f t_from, sf::Vector2f t_to, sf::Color t_colour);
+
+	/// <summary>
+	/// @brief Records the outline of a circle in world space.
+	/// </summary>
+	static void circle(sf::Vector2f t_centre, float t_radius, sf::Color t_colour);
+
+	/// <summary>
+	/// @brief Draws everything recorded since the last call in one draw call, then forgets it.
+	/// </summary>
+	/// <param name="t_target">The window (or texture) to draw to, with the world view set</param>
+	static void render(sf::RenderTarget & t_target);
+
+	/// <summary>
+	/// @brief Turns recording on or off. It is on by default.
+	/// </summary>
+	static void setEnabled(bool t_enabled);
+
+	static bool isEnabled() { return s_enabled; }
+
+private:
+	// The number of segments a circle is drawn with.
+	static const int s_CIRCLE_SEGMENTS = 24;
+
+	static bool s_enabled;
+
+	// Every recorded shape, as line segments.
+	static sf::VertexArray s_lines;
+#else
+	static void line(sf::Vector2f, sf::Vector2f, sf::Color) {}
+	static void circle(sf::Vector2f, float, sf::Color) {}
+	static void render(sf::RenderTarget &) {}
+	static void setEnabled(bool) {}
+	static constexpr bool isEnabled() { return false; }
+#endif // DEBUG_DRAW
+};
@@ -9,14 +9,23 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include "ScreenSize.h"
-#include "LevelLoader.h"
 #include <Thor/Resources.hpp>
-#include "Tank.h"
-#include "AITank.h"
+#include "World.h"
 #include "GameState.h"
 #include "HUD.h"
-#include "Projectile.h"
-#include <functional>
+#include "WallLayer.h"
+#include "Camera.h"
+#include "SpriteBatch.h"
+#include "RenderSnapshot.h"
+#include "DebugDraw.h"
+#include "TripleBuffer.h"
+#include "InputRecording.h"
+#include "Logger.h"
+#include "Profiler.h"
+#include "ProfilerOverlay.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
 /// <summary>
 /// @author RP
 /// @date September 2022
@@ -40,21 +49,33 @@ public:
 	/// @brief Default constructor that initialises the SFML window, 
 	///   and sets vertical sync enabled. 
 	/// </summary>
-	Game();
+	/// <param name="t_tickRate">The number of simulation updates per second</param>
+	explicit Game(double t_tickRate = World::s_DEFAULT_TICK_RATE);
 
 	/// <summary>
 	/// @brief the main game loop.
 	/// 
-	/// A complete loop involves processing SFML events, updating and drawing all game objects.
-	/// The actual elapsed time for a single game loop is calculated. If this value is 
-	///  greater than the target time for one loop (1 / 60), then (and only then) is an update 
-	///  operation performed.
-	/// The target is at least one update and one render cycle per game loop, but typically 
-	///  more render than update operations will be performed as we expect our game loop to
-	///  complete in less than the target time.
+	/// The simulation runs on its own thread (see simulate()), so a slow frame never delays it.
+	///  This thread only processes SFML events, samples the keyboard for the simulation and
+	///  draws the latest render snapshot the simulation published, as often as the display allows.
+	/// Every window system call is made from this thread: X11 shares one display connection
+	///  between threads, so reading the keyboard from the simulation thread would race with it.
 	/// </summary>
 	void run();
-	Game(std::vector<Projectile>& t_projectiles); // Constructor with projectiles reference
+
+	/// <summary>
+	/// @brief Records the input and state hash of every tick, and writes them to a file when
+	///  the game closes. Call before run().
+	/// </summary>
+	void recordTo(std::string const & t_fileName);
+
+	/// <summary>
+	/// @brief Drives the player tank from a recording instead of the keyboard, and logs the first
+	///  tick whose state hash differs from the recorded one. Once the recording runs out the
+	///  keyboard takes over. The game should run at the recording's tick rate. Call before run().
+	/// </summary>
+	void replay(InputRecording const & t_recording);
+
 
 protected:
 	/// <summary>
@@ -62,14 +83,28 @@ protected:
 	/// </summary>	
 	void init();
 	/// <summary>
-	/// @brief Placeholder to perform updates to all game objects.
+	/// @brief The simulation thread.
+	/// The simulation runs at a fixed tick rate: the elapsed real time is added to an accumulator
+	///  and one update of exactly one tick is performed for every whole tick in it, each followed
+	///  by publishing a render snapshot. If the thread fell so far behind that catching up would
+	///  take longer still, the excess time is dropped. Runs until m_running is cleared.
+	/// The player's input is the latest keyboard sample run() stored in m_keyboardControls.
+	/// </summary>
+	void simulate();
+
+	/// <summary>
+	/// @brief Fills the back render snapshot from the game objects and publishes it.
+	/// Simulation thread only (or before it starts).
 	/// </summary>
-	/// <param name="time">update delta time</param>
-	void update(double dt);
+	void publishSnapshot();
 
 	/// <summary>
 	/// @brief Draws the background and foreground game objects in the SFML window.
 	/// The render window is always cleared to black before anything is drawn.
+	/// Moving objects are drawn from the latest render snapshot, interpolated by the time since
+	///  it was published, and never read from the live game objects the simulation is updating.
+	/// The world is drawn through the camera, skipping anything outside its view,
+	///  then the HUD is drawn on top in screen space. The caller displays the frame.
 	/// </summary>
 	void render();
 
@@ -86,36 +121,55 @@ protected:
 	/// <param name="event">system event</param>
 	void processGameEvents(sf::Event&);
 
-	/// <summary>
-	/// @brief Creates the wall sprites and loads them into a vector.
-	/// /// Note that sf::Sprite is considered a light weight class, so 
-	/// /// storing copies (instead of pointers to sf::Sprite) in std::vector /// is acceptable.
-	/// </summary>
-	void generateWalls();
-	void setGameState(GameState newState);
-	std::vector<sf::Sprite> m_wallSprites;
+	// The walls baked into chunked vertex buffers, built once in init().
+	WallLayer m_wallLayer;
 	sf::Font m_arialFont;
 	sf::RenderWindow m_window;
-	sf::Sprite m_bgSprite;
-	sf::Sprite m_wallSprite;
-	LevelData m_level;
+	// The background, cut into tiles so those outside the view can be skipped.
+	std::vector<sf::Sprite> m_bgTiles;
+	static const int s_BACKGROUND_TILE_SIZE = 500;
 	thor::ResourceHolder<sf::Texture, std::string> m_holder;
-	Tank m_tank;
-	AITank m_aiTank;
-	//Projectile m_projectiles;
-	bool shouldTankRotate = false;
-	GameState m_gameState{ GameState::GAME_RUNNING };
+	// The simulation, only touched by the simulation thread once run() has started it.
+	World m_world;
 	sf::Font m_font;
 	HUD m_hud;
-	GameState m_currentGameState; // Store the current game state
-	//void setGameState(GameState newState);
-	GameState getGameState() const;
-	std::function<void(int)> m_funcApplyDamage;
+	// Follows the player tank; the world is drawn with its view and culled against it.
+	Camera m_camera;
+	// Every world sprite is drawn through this, so runs of sprite sheet sprites share a draw call.
+	SpriteBatch m_batch;
+	// The per-subsystem profiler times, toggled with F2.
+	ProfilerOverlay m_profilerOverlay;
+	// Seconds of simulated time per update.
+	double m_tickSeconds;
+
+	// The most real time one frame may add to the accumulator, so a long stall (a breakpoint,
+	//  dragging the window) is skipped rather than caught up on, which would stall again.
+	static constexpr double s_MAX_FRAME_SECONDS{ 0.25 };
+
+	// Render snapshots, written by the simulation thread and read by the main thread.
+	TripleBuffer<RenderSnapshot> m_snapshots;
+
+	// The simulation thread, and the flag telling it to stop.
+	std::thread m_simulation;
+	std::atomic<bool> m_running{ false };
+
+	// The controls held down when the main thread last sampled the keyboard, read by the simulation.
+	std::atomic<std::uint8_t> m_keyboardControls{ 0 };
+
+	// The recording being made or replayed, and the file it is saved to when recording.
+	InputRecording m_recording;
+	std::string m_recordFile;
+	bool m_replaying{ false };
+
+	// Ticks simulated so far, and whether a replay has stopped matching its recording.
+	int m_tick{ 0 };
+	bool m_diverged{ false };
+
 #ifdef TEST_FPS
 	sf::Text x_updateFPS;					// text used to display updates per second.
 	sf::Text x_drawFPS;						// text used to display draw calls per second.
-	sf::Time x_secondTime {sf::Time::Zero};	// counter used to establish when a second has passed.
-	int x_updateFrameCount{ 0 };			// updates per second counter.
+	sf::Clock x_secondClock;				// clock used to establish when a second has passed.
+	std::atomic<int> x_updateFrameCount{ 0 };	// updates per second counter, counted by the simulation thread.
 	int x_drawFrameCount{ 0 };				// draws per second counter.
 #endif // TEST_FPS
 
@@ -6,7 +6,7 @@
 /// <summary>
 /// @brief A basic HUD implementation.
 /// 
-/// Shows current game state only.
+/// Shows the current game state and the AI tank's health.
 /// </summary>
 
 class HUD
@@ -15,13 +15,17 @@ public:
     /// <summary>
     /// @brief Default constructor that stores a font for the HUD and initialises the general HUD appearance.
     /// </summary>
-    HUD(sf::Font& hudFont);
+    /// <param name="hudFont">The font of the game state text</param>
+    /// <param name="t_healthFont">The font of the health text, owned by the caller</param>
+    HUD(sf::Font& hudFont, sf::Font const & t_healthFont);
 
     /// <summary>
     /// @brief Checks the current game state and sets the appropriate status text on the HUD.
+    /// The health text is only laid out again when the health changes.
     /// </summary>
     /// <param name="gameState">The current game state</param>
-    void update(GameState const& gameState);
+    /// <param name="t_aiHealth">The AI tank's health, from a render snapshot</param>
+    void update(GameState const& gameState, int t_aiHealth);
 
     /// <summary>
     /// @brief Draws the HUD outline and text.
@@ -39,6 +43,10 @@ private:
     // A container for the current HUD text.
     sf::Text m_gameStateText;
 
+    // The AI tank's health, and the health it currently shows.
+    sf::Text m_healthText;
+    int m_shownHealth{ -1 };
+
     // A simple background shape for the HUD.
     sf::RectangleShape m_hudOutline;
 };
\ No newline at end of file
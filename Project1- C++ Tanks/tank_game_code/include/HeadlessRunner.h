@@ -0,0 +1,64 @@
+#pragma once
+
+#include "World.h"
+#include "InputScript.h"
+#include "InputRecording.h"
+#include "Profiler.h"
+
+/// <summary>
+/// @brief Plays matches with no window, GPU or fonts, for batch runs and benchmarks.
+///
+/// Each match builds a fresh World from the level file and steps it as fast as possible, with
+///  the player driven by an input script, until one side wins or the tick limit is reached.
+///  Every tick is the same simulated length as in the game, so a match plays out exactly as it
+///  would on screen; only the waiting between ticks is skipped. A summary of the outcomes and
+///  the simulation speed, with the profiled time of each subsystem, is written to the console at the end.
+/// Example usage:
+///		HeadlessRunner runner(script, 60.0, 18000);
+///		runner.run(100);
+/// </summary>
+class HeadlessRunner
+{
+public:
+	/// <param name="t_script">The input script for the player tank</param>
+	/// <param name="t_tickRate">The number of simulation updates per simulated second</param>
+	/// <param name="t_maxTicks">The most ticks a match may last before it counts as a draw</param>
+	HeadlessRunner(InputScript const & t_script, double t_tickRate, int t_maxTicks);
+
+	/// <summary>
+	/// @brief Plays the given number of matches, then writes the summary.
+	/// </summary>
+	void run(int t_matches);
+
+	/// <summary>
+	/// @brief Records the first match run() plays to a file. Call before run().
+	/// </summary>
+	void recordTo(std::string const & t_fileName);
+
+	/// <summary>
+	/// @brief Plays a recording back, checking the state hash after every tick, and writes
+	///  whether it matched or the first tick it diverged at.
+	/// </summary>
+	/// <returns>True if every tick matched the recording</returns>
+	bool replay(InputRecording const & t_recording);
+
+private:
+	/// <summary>
+	/// @brief Plays one match from the start of the script.
+	/// </summary>
+	/// <param name="t_outcome">Set to the game state the match ended in</param>
+	/// <param name="t_seconds">Set to the real time spent updating, leaving out building the world</param>
+	/// <param name="t_recording">If not null, every tick is recorded to it</param>
+	/// <returns>The number of ticks the match lasted</returns>
+	int runMatch(GameState & t_outcome, double & t_seconds, InputRecording * t_recording);
+
+	InputScript m_script;
+
+	// The file the first match is recorded to, if any.
+	std::string m_recordFile;
+
+	// Milliseconds of simulated time per update.
+	double m_tickMilliseconds;
+
+	int m_maxTicks;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+/// <summary>
+/// @brief The objects a projectile can hit.
+/// </summary>
+enum class HitTarget
+{
+	PLAYER_TANK,
+	AI_TANK
+};
+
+/// <summary>
+/// @brief One projectile hit, recorded when it is detected and handled later in the tick.
+/// </summary>
+struct HitEvent
+{
+	// What was hit.
+	HitTarget m_target;
+
+	// The damage dealt by the projectile.
+	int m_damage;
+
+	// Where the projectile was when it hit, in world space.
+	sf::Vector2f m_point;
+};
+
+/// <summary>
+/// @brief A fixed capacity queue of the hits detected during one tick.
+/// When it is full push() refuses the hit; the caller keeps whatever caused it, e.g. a shell
+///  stays in flight, so it can be pushed again on the next tick.
+///
+/// Collision code pushes a plain record per hit instead of calling back into the target,
+///  then every interested system (damage, HUD, audio, effects...) reads the whole batch
+///  once, and the queue is cleared at the end of the tick.
+/// Storage is allocated once up front, so pushing never allocates.
+/// Example usage:
+///		hits.push(HitEvent{ HitTarget::AI_TANK, damage, position });
+///		for (HitEvent const & hit : hits) { ... }
+///		hits.clear();
+/// </summary>
+class HitEventQueue
+{
+public:
+	/// <summary>
+	/// @brief Creates an empty queue.
+	/// </summary>
+	/// <param name="t_capacity">The most hits that can be recorded in one tick</param>
+	explicit HitEventQueue(int t_capacity = s_DEFAULT_CAPACITY);
+
+	/// <summary>
+	/// @brief Records a hit.
+	/// </summary>
+	/// <returns>False if the queue is full and the hit was dropped</returns>
+	bool push(HitEvent const & t_event);
+
+	/// <summary>
+	/// @brief Forgets every recorded hit.
+	/// </summary>
+	void clear();
+
+	int size() const;
+	bool empty() const;
+
+	std::vector<HitEvent>::const_iterator begin() const;
+	std::vector<HitEvent>::const_iterator end() const;
+
+private:
+	static const int s_DEFAULT_CAPACITY = 64;
+
+	// Reserved up front and never grown.
+	std::vector<HitEvent> m_events;
+};
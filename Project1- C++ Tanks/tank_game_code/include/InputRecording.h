@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "TankInput.h"
+
+/// <summary>
+/// @brief A recorded match: the player input of every tick and the state hash after it.
+///
+/// The simulation is deterministic for a given level, tick rate and input stream, so playing
+///  the inputs back reproduces the match exactly, tick for tick. The hashes show where a
+///  replay stops matching the recording, i.e. the first tick whose simulation changed.
+/// Recordings are binary: a header, one byte of input per tick, then one hash per tick.
+/// Example usage:
+///		// Recording
+///		recording.begin(tickRate, world.stateHash());
+///		recording.add(input, world.stateHash());
+///		recording.save("match.rec");
+///		// Replaying
+///		recording.load("match.rec");
+///		world.update(dt, recording.input(tick));
+///		if (!recording.matches(tick, world.stateHash())) { ... }
+/// </summary>
+class InputRecording
+{
+public:
+	/// <summary>
+	/// @brief Discards any recorded ticks and starts a new recording.
+	/// </summary>
+	/// <param name="t_tickRate">The number of simulation updates per second</param>
+	/// <param name="t_initialHash">The state hash of the world before the first tick</param>
+	void begin(double t_tickRate, std::uint64_t t_initialHash);
+
+	/// <summary>
+	/// @brief Appends one tick.
+	/// </summary>
+	/// <param name="t_input">The input the tick was updated with</param>
+	/// <param name="t_hash">The state hash of the world after the tick</param>
+	void add(TankInput t_input, std::uint64_t t_hash);
+
+	/// <summary>
+	/// @brief Writes the recording to a file. Will generate an exception if it cannot.
+	/// </summary>
+	void save(std::string const & t_fileName) const;
+
+	/// <summary>
+	/// @brief Reads a recording from a file, replacing this one.
+	/// Will generate an exception if the file cannot be read or is not a recording.
+	/// </summary>
+	void load(std::string const & t_fileName);
+
+	/// <summary>
+	/// @brief Returns the recorded input of a tick, or no input past the end of the recording.
+	/// </summary>
+	TankInput input(int t_tick) const;
+
+	/// <summary>
+	/// @brief Returns true if a state hash after a tick is the one recorded for it.
+	/// Ticks past the end of the recording always match.
+	/// </summary>
+	bool matches(int t_tick, std::uint64_t t_hash) const;
+
+	int tickCount() const;
+	double tickRate() const;
+	std::uint64_t initialHash() const;
+
+private:
+	double m_tickRate{ 60.0 };
+	std::uint64_t m_initialHash{ 0 };
+	std::vector<std::uint8_t> m_inputs;
+	std::vector<std::uint64_t> m_hashes;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "TankInput.h"
+
+/// <summary>
+/// @brief A scripted source of player input, for running the game without a keyboard.
+///
+/// A script is a list of steps, each holding a set of controls down for a number of ticks,
+///  read from a YAML file. Once the last step ends the script starts over, so a short script
+///  can drive a match of any length.
+/// Example script:
+///		steps:
+///		   - {ticks: 120, controls: [ACCELERATE, FIRE]}
+///		   - {ticks: 45, controls: [TURN_RIGHT]}
+/// Example usage:
+///		InputScript script;
+///		script.load("./resources/scripts/patrol.yaml");
+///		world.update(dt, script.next());
+/// </summary>
+class InputScript
+{
+public:
+	/// <summary>
+	/// @brief Reads the steps of a script file, replacing any loaded before.
+	/// Will generate an exception if the file cannot be read or names an unknown control.
+	/// </summary>
+	/// <param name="t_fileName">The path of the YAML script</param>
+	void load(std::string const & t_fileName);
+
+	/// <summary>
+	/// @brief Returns the input for the next tick. A script without steps presses nothing.
+	/// </summary>
+	TankInput next();
+
+	/// <summary>
+	/// @brief Goes back to the first tick of the first step.
+	/// </summary>
+	void restart();
+
+private:
+	struct Step
+	{
+		int m_ticks;
+		TankInput m_input;
+	};
+
+	std::vector<Step> m_steps;
+
+	// The current step, and how many of its ticks have been played.
+	int m_step{ 0 };
+	int m_tick{ 0 };
+};
@@ -4,7 +4,7 @@
 #include <vector>
 #include <fstream>
 #include <iostream>
-#include "yaml-cpp\yaml.h"
+#include "yaml-cpp/yaml.h"
 
 /// <summary>
 /// @brief A struct to represent Obstacle data in the level.
@@ -26,6 +26,34 @@ struct BackgroundData
 	std::string m_fileName;
 };
 
+/// <summary>
+/// @brief A struct to represent a projectile archetype, i.e. how the shells of a weapon behave.
+/// 
+/// </summary>
+struct ProjectileData
+{
+	// Movement speed in pixels per second.
+	float m_speed{ 1000.0f };
+	// How long a shell stays in flight, in seconds.
+	float m_lifetime{ 3.0f };
+	// Damage dealt to a tank on a hit.
+	int m_damage{ 1 };
+};
+
+/// <summary>
+/// @brief A struct to represent the weapon of a tank.
+/// 
+/// The projectile pool of the tank is sized to m_maxProjectiles.
+/// </summary>
+struct WeaponData
+{
+	// The most shells the tank can have in flight at once.
+	int m_maxProjectiles{ 10 };
+	// Time between shots in milliseconds.
+	int m_reloadTime{ 800 };
+	ProjectileData m_projectile;
+};
+
 /// <summary>
 /// @brief A struct to represent tank data in the level.
 /// 
@@ -34,6 +62,7 @@ struct TankData
 {
 	sf::Vector2f m_position;
 	float m_scale;
+	WeaponData m_weapon;
 };
 
 /// <summary>
@@ -49,8 +78,7 @@ struct AITankData
 {
 	sf::Vector2f m_position;
 	sf::Vector2f m_scale;
-	int m_maxProjectiles;
-	int m_reloadTime;
+	WeaponData m_weapon;
 };
 
 struct LevelData
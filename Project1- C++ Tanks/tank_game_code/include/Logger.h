@@ -0,0 +1,181 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+/// <summary>
+/// @brief How important a log record is. A category logs records at or above its level.
+/// </summary>
+enum class LogLevel
+{
+	TRACE,		// Every tick, e.g. steering vectors.
+	DEBUG,		// Individual events, e.g. a ray hitting an obstacle.
+	INFO,		// Game events, e.g. a tank taking damage.
+	WARNING,
+	CRITICAL,
+	OFF			// Only used as a category level, to silence it.
+};
+
+/// <summary>
+/// @brief The subsystems records are logged from, each filtered separately.
+/// </summary>
+enum class LogCategory
+{
+	GENERAL,
+	AI,
+	COMBAT,
+	COLLISION,
+	LEVEL,
+	RENDER,
+	COUNT
+};
+
+/// <summary>
+/// @brief One argument of a log record, stored by value so formatting can happen later.
+/// Strings are stored as pointers and must outlive the record, i.e. be string literals.
+/// There is a constructor for every standard integer type from int up, rather than for
+///  std::size_t, which is unsigned long on some platforms and unsigned long long on others.
+/// </summary>
+struct LogArg
+{
+	enum class Type { INTEGER, REAL, TEXT };
+
+	LogArg() : m_type(Type::INTEGER), m_integer(0) {}
+	LogArg(int t_value) : m_type(Type::INTEGER), m_integer(t_value) {}
+	LogArg(unsigned t_value) : m_type(Type::INTEGER), m_integer(t_value) {}
+	LogArg(long t_value) : m_type(Type::INTEGER), m_integer(t_value) {}
+	LogArg(unsigned long t_value) : m_type(Type::INTEGER), m_integer(static_cast<long long>(t_value)) {}
+	LogArg(long long t_value) : m_type(Type::INTEGER), m_integer(t_value) {}
+	LogArg(unsigned long long t_value) : m_type(Type::INTEGER), m_integer(static_cast<long long>(t_value)) {}
+	LogArg(bool t_value) : m_type(Type::INTEGER), m_integer(t_value) {}
+	LogArg(float t_value) : m_type(Type::REAL), m_real(t_value) {}
+	LogArg(double t_value) : m_type(Type::REAL), m_real(t_value) {}
+	LogArg(char const * t_value) : m_type(Type::TEXT), m_text(t_value) {}
+
+	Type m_type;
+	union
+	{
+		long long m_integer;
+		double m_real;
+		char const * m_text;
+	};
+};
+
+/// <summary>
+/// @brief An asynchronous, levelled and category filtered logger.
+///
+/// Logging a record only copies the format string pointer and the argument values into a
+///  slot of a fixed size lock-free ring buffer; a background thread formats the records and
+///  writes them to the console. The game thread therefore never formats, allocates, locks or
+///  waits on console I/O. If the ring is full the record is dropped and counted instead.
+/// Each category has a minimum level, and a record below it costs one inline comparison.
+/// Any number of threads may log. Until start() is called every category is OFF.
+/// Formats use {} as the placeholder for the next argument.
+/// Example usage:
+///		Logger::start();
+///		Logger::log(LogLevel::INFO, LogCategory::COMBAT, "AI tank health: {}", health);
+///		Logger::stop();
+/// </summary>
+class Logger
+{
+public:
+	/// <summary>
+	/// @brief Starts the writer thread and sets every category to the given level.
+	/// </summary>
+	static void start(LogLevel t_level = LogLevel::INFO);
+
+	/// <summary>
+	/// @brief Writes every record still queued, then stops the writer thread.
+	/// Waits for any thread still inside log() to finish, so its record is written too.
+	/// </summary>
+	static void stop();
+
+	/// <summary>
+	/// @brief Sets the lowest level logged for a category.
+	/// </summary>
+	static void setLevel(LogCategory t_category, LogLevel t_level);
+
+	/// <summary>
+	/// @brief Returns true if records of the given level and category are logged.
+	/// </summary>
+	static bool isEnabled(LogLevel t_level, LogCategory t_category)
+	{
+		return static_cast<int>(t_level) >= s_levels[static_cast<int>(t_category)].load(std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// @brief Queues a record, if its level is enabled for its category.
+	/// </summary>
+	/// <param name="t_format">A string literal, with {} for each argument</param>
+	/// <param name="t_args">At most four numbers or string literals</param>
+	template <typename... Args>
+	static void log(LogLevel t_level, LogCategory t_category, char const * t_format, Args... t_args)
+	{
+		static_assert(sizeof...(Args) <= s_MAX_ARGS, "Too many log arguments");
+		if (isEnabled(t_level, t_category))
+		{
+			LogArg args[s_MAX_ARGS] = { LogArg(t_args)... };
+			push(t_level, t_category, t_format, args, static_cast<int>(sizeof...(Args)));
+		}
+	}
+
+private:
+	static const int s_MAX_ARGS = 4;
+
+	// Must be a power of two.
+	static const std::size_t s_CAPACITY = 4096;
+
+	/// <summary>
+	/// @brief A slot of the ring buffer.
+	/// </summary>
+	struct Record
+	{
+		// Which lap of the ring the slot is on, and whether it is full or empty on that lap.
+		std::atomic<std::size_t> m_sequence;
+
+		std::chrono::steady_clock::time_point m_time;
+		LogLevel m_level;
+		LogCategory m_category;
+		char const * m_format;
+		int m_argCount;
+		LogArg m_args[s_MAX_ARGS];
+	};
+
+	/// <summary>
+	/// @brief Claims a slot and fills it. Drops the record if the ring is full.
+	/// </summary>
+	static void push(LogLevel t_level, LogCategory t_category, char const * t_format, LogArg const * t_args, int t_argCount);
+
+	/// <summary>
+	/// @brief The writer thread: formats and writes records until stopped.
+	/// </summary>
+	static void run();
+
+	/// <summary>
+	/// @brief Formats and writes every record queued so far.
+	/// </summary>
+	/// <returns>The number of records written</returns>
+	static int drain();
+
+	static std::atomic<int> s_levels[static_cast<int>(LogCategory::COUNT)];
+
+	static Record s_ring[s_CAPACITY];
+
+	// The next slot to fill, shared by every logging thread.
+	static std::atomic<std::size_t> s_enqueuePosition;
+
+	// The next slot to write out, only touched by the writer thread.
+	static std::size_t s_dequeuePosition;
+
+	// Records dropped because the ring was full.
+	static std::atomic<std::size_t> s_dropped;
+
+	// Threads currently inside push(), which stop() waits for.
+	static std::atomic<int> s_producers;
+
+	static std::atomic<bool> s_running;
+	static std::thread s_writer;
+	static std::chrono::steady_clock::time_point s_startTime;
+};
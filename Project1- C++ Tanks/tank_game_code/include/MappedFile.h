@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/// <summary>
+/// @brief A read only memory mapping of a whole file.
+///
+/// The operating system pages the file in on demand and shares it between processes,
+///  so large baked data (e.g. collision masks) can be used straight from disk without
+///  being read or copied. Uses CreateFileMapping on Windows and mmap elsewhere.
+/// </summary>
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(MappedFile const &) = delete;
+	MappedFile & operator=(MappedFile const &) = delete;
+
+	/// <summary>
+	/// @brief Maps the given file, unmapping any file mapped before.
+	/// </summary>
+	/// <param name="t_path">The file to map</param>
+	/// <returns>False if the file does not exist, is empty or cannot be mapped</returns>
+	bool open(std::string const & t_path);
+
+	/// <summary>
+	/// @brief Unmaps the file. Pointers returned by data() are no longer valid.
+	/// </summary>
+	void close();
+
+	/// <summary>
+	/// @brief The first byte of the mapping (page aligned), or nullptr if nothing is mapped.
+	/// </summary>
+	unsigned char const * data() const;
+
+	/// <summary>
+	/// @brief The size of the mapping in bytes.
+	/// </summary>
+	std::size_t size() const;
+
+private:
+	unsigned char const * m_data{ nullptr };
+	std::size_t m_size{ 0 };
+
+	// Operating system handles (Windows only).
+	void * m_file{ nullptr };
+	void * m_mapping{ nullptr };
+};
@@ -36,4 +36,21 @@ namespace MathUtility
 	sf::Vector2f truncate(sf::Vector2f v, float const max);
 	float smoothRotate(float currentRotation, float targetRotation, float maxRotationSpeed);
 
+	/// <summary>
+	/// @brief Returns the angle a fraction of the way from one angle to another, turning the shortest way round.
+	/// </summary>
+	/// <param name="from">An angle in degrees</param>
+	/// <param name="to">An angle in degrees</param>
+	/// <param name="alpha">0 for from, 1 for to</param>
+	float lerpAngle(float from, float to, float alpha);
+
+	/// <summary>
+	/// @brief Returns a copy of a sprite moved and rotated back towards its transform at the end
+	///  of the previous tick, for drawing between two simulation ticks.
+	/// </summary>
+	/// <param name="current">The sprite as of the last tick</param>
+	/// <param name="previous">Its transform as of the tick before</param>
+	/// <param name="alpha">How far between the two ticks to draw it, 0 for previous, 1 for current</param>
+	sf::Sprite interpolate(sf::Sprite const & current, sf::Transformable const & previous, float alpha);
+
 }
\ No newline at end of file
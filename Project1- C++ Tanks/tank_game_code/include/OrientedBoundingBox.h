@@ -1,6 +1,7 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <vector>
 
 /// <summary>
 /// @brief Collision detection class for bounding box collisions using the Separating Axis Theorem (SAT)
@@ -21,5 +22,37 @@ public:
 
 	sf::Vector2f Points[4];
 
-	void ProjectOntoAxis(const sf::Vector2f& Axis, float& Min, float& Max); // Project all four points of the OBB onto the given axis and return the dotproducts of the two outermost points
+	void ProjectOntoAxis(const sf::Vector2f& Axis, float& Min, float& Max) const; // Project all four points of the OBB onto the given axis and return the dotproducts of the two outermost points
+};
+
+class StaticCollider // An OBB for a sprite that never moves again, e.g. a wall, with everything about it that SAT needs precomputed
+{
+public:
+	StaticCollider(const sf::Sprite& Object); // Calculate the points, edge axes and projections of the OBB once
+
+	sf::Vector2f Points[4];
+
+	sf::Vector2f Axes[2]; // The two distinct edge axes of the OBB (the other two edges are parallel to these)
+
+	float Min[2]; // The outermost projections of the OBB onto each of its own axes
+	float Max[2];
+
+	void ProjectOntoAxis(const sf::Vector2f& Axis, float& Min, float& Max) const; // Project all four points of the OBB onto the given axis and return the dotproducts of the two outermost points
+};
+
+class ObbBatch // Many static OBBs stored as a structure of arrays, so one box can be tested against several of them per instruction
+{
+public:
+	void Add(const StaticCollider& Box); // Append a box; its index is the number of boxes added before it
+	void Clear();
+	int Count() const;
+
+	std::vector<float> X[4]; // Corner i of box b is (X[i][b], Y[i][b])
+	std::vector<float> Y[4];
+
+	std::vector<float> AxisX[2]; // Edge axis i of box b is (AxisX[i][b], AxisY[i][b])
+	std::vector<float> AxisY[2];
+
+	std::vector<float> Min[2]; // The outermost projections of box b onto its own axis i
+	std::vector<float> Max[2];
 };
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "Profiler.h"
+
+/// <summary>
+/// @brief Shows the rolling per-subsystem times from the Profiler on screen.
+///
+/// Twice a second the profiler is sampled and the text is rebuilt, listing for every zone
+///  its calls per second and its mean and longest time per call in that window.
+/// Toggled with F2; drawn in screen space over the HUD.
+/// </summary>
+class ProfilerOverlay
+{
+public:
+	/// <summary>
+	/// @brief Sets the overlay's appearance. The font must outlive the overlay.
+	/// </summary>
+	explicit ProfilerOverlay(sf::Font const & t_font);
+
+	void setVisible(bool t_visible);
+	bool isVisible() const;
+
+	/// <summary>
+	/// @brief Samples the profiler if the window has elapsed, then draws the breakdown.
+	/// Does nothing while hidden.
+	/// </summary>
+	void render(sf::RenderWindow & t_window);
+
+private:
+	// How often the profiler is sampled and the text rebuilt.
+	static constexpr float s_SAMPLE_SECONDS{ 0.5f };
+
+	// The zone names, calls per second, mean and longest times, one text per column so
+	//  they line up whatever the font.
+	static const int s_COLUMNS = 4;
+
+	bool m_visible{ false };
+	sf::Clock m_sampleClock;
+	sf::Text m_columns[s_COLUMNS];
+	sf::RectangleShape m_background;
+};
@@ -1,55 +1,236 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <array>
-#include "Projectile.h"
-#include <functional>
+#include <vector>
+#include "ScreenSize.h"
+#include "MathUtility.h"
+#include "CollisionDetector.h"
+#include "WallGrid.h"
+#include "LevelLoader.h"
+#include "RenderSnapshot.h"
+#include "StateHash.h"
 
+/// <summary>
+/// @brief A pool of projectiles (tank shells), stored as a structure of arrays.
+///
+/// A shell in flight is nothing but a position, a velocity and the time it has left to live,
+///  each kept in its own contiguous array, and its quad is only built when it is drawn.
+/// The arrays are dense: shells in flight occupy the first activeCount() entries, and a retired
+///  shell is replaced by the last one. Integration, sweeping and drawing therefore only touch
+///  shells in flight, in one loop the compiler can vectorise.
+/// Each shell is also known by a slot, which stays the same for as long as the shell is in flight
+///  (the broadphase uses it as a handle). Free slots are threaded into an intrusive free list,
+///  so creating and retiring a shell are O(1). Slots in flight are also linked in the order they
+///  were fired, so the oldest shell is found in O(1) when EVICT_OLDEST needs room.
+/// </summary>
 class ProjectilePool
 {
 public:
+	/// <summary>
+	/// @brief What create() does when every slot is in flight.
+	/// </summary>
+	enum class OverflowPolicy
+	{
+		REFUSE,			// No shell is fired.
+		GROW,			// The pool doubles its capacity.
+		EVICT_OLDEST	// The shell that has been in flight longest is retired to make room.
+	};
 
 	/// <summary>
-	/// @brief No-op default constructor
+	/// @brief Creates an empty pool.
 	/// </summary>
-	ProjectilePool() = default;
+	/// <param name="t_capacity">The number of shells that can be in flight at once.
+	///  Throws std::invalid_argument if it is less than 1.</param>
+	/// <param name="t_archetype">The speed, lifetime and damage of every shell in the pool.
+	///  Throws std::invalid_argument if the speed is not positive.</param>
+	/// <param name="t_policy">What to do when a shell is fired while the pool is full</param>
+	explicit ProjectilePool(int t_capacity = s_DEFAULT_CAPACITY, ProjectileData const & t_archetype = ProjectileData(),
+		OverflowPolicy t_policy = OverflowPolicy::EVICT_OLDEST);
 
 	/// <summary>
-	/// @brief Creates a projectile.
-	/// Creates a projectile from the pool of available projectiles.
-	///  If no projectiles are available, the next in (pool) sequence after
-	///  the last used projectile is chosen.
+	/// @brief Creates a projectile moving at the archetype's speed along the given rotation.
+	/// If the pool is full, the overflow policy decides what happens.
 	/// </summary>
-	/// <param name="t_texture">A reference to the sprite sheet texture</param>	
+	/// <param name="t_texture">The sprite sheet texture, or nullptr when headless</param>
 	/// <param name="t_x">The x position of the projectile</param>
 	/// <param name="t_y">The y position of the projectile</param>
 	/// <param name="t_rotation">The rotation angle of the projectile in degrees</param>
-	void create(sf::Texture const & t_texture, double t_x, double t_y, double t_rotation);
+	/// <returns>The slot of the new projectile, or -1 if the pool is full and refused it</returns>
+	int create(sf::Texture const * t_texture, double t_x, double t_y, double t_rotation);
+
+	/// <summary>
+	/// @brief Updates all projectiles in flight.
+	/// Every shell is moved along its velocity, then its path is swept against the walls near it.
+	///  A shell that hits a wall is stopped at the point of impact and retired, as is a shell
+	///  that left the world or outlived its lifetime.
+	/// </summary>
+	/// <param name="dt">The delta time</param>
+	/// <param name="t_wallGrid">The broadphase grid over the wall sprites</param>
+	void update(double t_dt, WallGrid const & t_wallGrid);
+
+	/// <summary>
+	/// @brief Remembers where every shell is now, as the start of the next tick for render interpolation.
+	/// Called at the start of every simulation tick, whether or not update() is.
+	/// </summary>
+	void storePreviousState();
+
+	/// <summary>
+	/// @brief Copies the previous and current position and the heading of every shell in flight
+	///  into a render snapshot, replacing its contents.
+	/// </summary>
+	void snapshot(std::vector<ShellSnapshot> & t_shells) const;
+
+	/// <summary>
+	/// @brief Adds the position, velocity and remaining lifetime of every shell in flight to a state hash.
+	/// </summary>
+	void hash(StateHash & t_hash) const;
+
+	/// <summary>
+	/// @brief Returns the texture shells are drawn with, or nullptr if none was ever fired.
+	/// </summary>
+	sf::Texture const * texture() const;
+
+	/// <summary>
+	/// @brief Draws the shells of a render snapshot that the camera can see.
+	/// Every visible shell is added to the batch as one textured quad, so however many shells
+	///  are in flight they share the draw call of the sprites around them.
+	/// </summary>
+	/// <param name="t_shells">The shells of a render snapshot</param>
+	/// <param name="t_texture">The texture the shells are drawn with</param>
+	/// <param name="t_batch">The sprite batch the world is drawn with</param>
+	/// <param name="t_camera">The camera the world is drawn with</param>
+	/// <param name="t_alpha">How far between the previous and the last tick to draw the shells</param>
+	static void render(std::vector<ShellSnapshot> const & t_shells, sf::Texture const * t_texture,
+		SpriteBatch & t_batch, Camera const & t_camera, float t_alpha);
+
+	/// <summary>
+	/// @brief Sets the area shells are retired on leaving. Defaults to the screen.
+	/// </summary>
+	void setWorldBounds(sf::FloatRect const & t_worldBounds);
+
+	/// <summary>
+	/// @brief Returns the number of projectile slots in the pool.
+	/// </summary>
+	int capacity() const;
+
+	/// <summary>
+	/// @brief Returns the number of projectiles in flight.
+	/// </summary>
+	int activeCount() const;
+
+	/// <summary>
+	/// @brief Returns the slot of the i'th projectile in flight, for iterating over them.
+	/// The order changes whenever a projectile is created or retired.
+	/// </summary>
+	/// <param name="t_index">An index less than activeCount()</param>
+	int activeSlot(int t_index) const;
 
 	/// <summary>
-	/// @brief Updates all projectiles in the pool.
-	/// Sets an index to the next available projectile. Also sets a 
-	///  status flag to indicate pool full (all projectiles in use).
+	/// @brief Returns true if the projectile in the given slot is currently in flight.
 	/// </summary>
-	/// <param name="dt">The delta time</param>	
-	/// <param name="rotation">A reference to the container of wall sprites</param>
-	void update(double t_dt, std::vector<sf::Sprite> & t_wallSprites, sf::Sprite t_base, std::function<void(int)> t_funcApplyDamage);
+	/// <param name="t_slot">A slot index less than capacity()</param>
+	bool isActive(int t_slot) const;
 
 	/// <summary>
-	/// @brief Draws all active projectiles.
+	/// @brief Returns the world space bounding box of the projectile in the given slot.
 	/// </summary>
-	/// <param name="window">The SFML render window</param>	
-	void render(sf::RenderWindow & t_window);
+	/// <param name="t_slot">A slot holding a projectile in flight</param>
+	sf::FloatRect bounds(int t_slot) const;
+
+	/// <summary>
+	/// @brief Returns the world space position of the projectile in the given slot.
+	/// </summary>
+	/// <param name="t_slot">A slot holding a projectile in flight</param>
+	sf::Vector2f position(int t_slot) const;
+
+	/// <summary>
+	/// @brief Returns the damage a projectile from this pool deals on a hit, as set by its archetype.
+	/// </summary>
+	int damage() const;
+
+	/// <summary>
+	/// @brief Takes the projectile in the given slot out of flight, e.g. after it hit a tank.
+	/// </summary>
+	/// <param name="t_slot">A slot holding a projectile in flight</param>
+	void retire(int t_slot);
 
 
 private:
-	static const int s_POOL_SIZE = 100;
+	/// <summary>
+	/// @brief Sweeps the path of one shell from its old to its new position against the walls.
+	/// On a hit the new position is pulled back to the point of impact.
+	/// </summary>
+	/// <param name="t_index">A dense index less than activeCount()</param>
+	/// <returns>True if the shell hit a wall.</returns>
+	bool sweepWalls(int t_index, WallGrid const & t_wallGrid);
+
+	/// <summary>
+	/// @brief Removes the shell at a dense index by moving the last shell into its place,
+	///  unlinks its slot from the firing order and puts it back on the free list.
+	/// </summary>
+	void removeAt(int t_index);
+
+	/// <summary>
+	/// @brief Resizes every array to the given number of slots and frees the new slots.
+	/// </summary>
+	void setCapacity(int t_capacity);
+
+	bool isInWorld(float t_x, float t_y) const;
+
+	static const int s_DEFAULT_CAPACITY = 100;
+
+	// The sprite sheet rectangle of a shell.
+	static const sf::IntRect s_PROJECTILE_RECT;
+
+	// How every shell in the pool moves, how long it lives and the damage it deals.
+	ProjectileData m_archetype;
+
+	OverflowPolicy m_policy;
+
+	// Shells leaving this area are retired.
+	sf::FloatRect m_worldBounds{ 0.0f, 0.0f, ScreenSize::s_width, ScreenSize::s_height };
+
+	// Dense arrays, one entry per shell in flight.
+	// Positions at the end of the last update, and where this update moves them to.
+	std::vector<float> m_x;
+	std::vector<float> m_y;
+	std::vector<float> m_newX;
+	std::vector<float> m_newY;
+
+	// Positions at the start of the last tick, drawn from when rendering between ticks.
+	std::vector<float> m_previousX;
+	std::vector<float> m_previousY;
+
+	// Velocities in pixels per second.
+	std::vector<float> m_vx;
+	std::vector<float> m_vy;
+
+	// Seconds each shell has left in flight.
+	std::vector<float> m_lifetime;
+
+	// The slot of each shell.
+	std::vector<int> m_slot;
+
+	// The number of shells in flight, i.e. the used part of the dense arrays.
+	int m_activeCount { 0 };
+
+	// Per slot arrays.
+	// The dense index of the shell in each slot, or -1 if the slot is free.
+	std::vector<int> m_index;
+
+	// For a free slot, the next free slot (-1 ends the list).
+	std::vector<int> m_nextFree;
+
+	// The head of the free list, -1 when every slot is in flight.
+	int m_firstFree { -1 };
 
-	// A container for the projectiles.
-	std::array<Projectile, s_POOL_SIZE> m_projectiles;
+	// For a slot in flight, the slots fired just before and just after it (-1 ends the list).
+	std::vector<int> m_olderSlot;
+	std::vector<int> m_newerSlot;
 
-	// The index of the next available projectile.
-	int m_nextAvailable { 0 };
+	// The ends of the firing order, -1 when no shell is in flight.
+	int m_oldestSlot { -1 };
+	int m_newestSlot { -1 };
 
-	// A flag indicating whether there are any projectiles available (initially they are).
-	bool m_poolFull { false };
-};
\ No newline at end of file
+	// The texture shells are drawn with, set by create().
+	sf::Texture const * m_texture{ nullptr };
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <vector>
+#include "GameState.h"
+#include "Camera.h"
+#include "SpriteBatch.h"
+
+/// <summary>
+/// @brief How a tank looked at the start and at the end of one simulation tick.
+/// </summary>
+struct TankSnapshot
+{
+	// The sprites as of the end of the tick.
+	sf::Sprite m_base;
+	sf::Sprite m_turret;
+
+	// Their transforms as of the start of the tick.
+	sf::Transformable m_previousBase;
+	sf::Transformable m_previousTurret;
+
+	/// <summary>
+	/// @brief Adds the base and turret to the batch, t_alpha of the way through the tick,
+	///  unless the camera cannot see either of them.
+	/// </summary>
+	void render(SpriteBatch & t_batch, Camera const & t_camera, float t_alpha) const;
+
+	/// <summary>
+	/// @brief Returns the position of the base t_alpha of the way through the tick.
+	/// </summary>
+	sf::Vector2f position(float t_alpha) const;
+};
+
+/// <summary>
+/// @brief Where one shell was at the start and at the end of one simulation tick.
+/// </summary>
+struct ShellSnapshot
+{
+	float m_previousX;
+	float m_previousY;
+	float m_x;
+	float m_y;
+
+	// The unit vector the shell is flying along.
+	float m_headingX;
+	float m_headingY;
+};
+
+/// <summary>
+/// @brief An obstacle circle the AI steers around.
+/// </summary>
+struct ObstacleSnapshot
+{
+	sf::Vector2f m_centre;
+	float m_radius;
+};
+
+/// <summary>
+/// @brief The AI steering rays at the end of one simulation tick, and the obstacles it
+///  avoids, for the debug draw layer.
+/// </summary>
+struct SteeringSnapshot
+{
+	sf::Vector2f m_position;
+	sf::Vector2f m_ahead;
+	sf::Vector2f m_aheadLeft;
+	sf::Vector2f m_aheadRight;
+
+	// Every obstacle, and the index of the one being avoided, or -1.
+	std::vector<ObstacleSnapshot> m_obstacles;
+	int m_mostThreatening{ -1 };
+
+	/// <summary>
+	/// @brief Records the steering rays, and the obstacle circles the camera can see, with DebugDraw.
+	/// </summary>
+	void renderDebug(Camera const & t_camera) const;
+};
+
+/// <summary>
+/// @brief Everything the render thread needs to draw one simulation tick.
+///
+/// The simulation thread fills a snapshot at the end of every tick and publishes it through
+///  a TripleBuffer. Once published a snapshot is never changed, so the render thread can
+///  draw it without ever touching the live game objects.
+/// </summary>
+struct RenderSnapshot
+{
+	// When the snapshot was published; the render thread interpolates by the time since.
+	std::chrono::steady_clock::time_point m_publishTime;
+
+	TankSnapshot m_player;
+	TankSnapshot m_ai;
+
+	// The player's shells in flight, and the texture they are drawn with.
+	std::vector<ShellSnapshot> m_shells;
+	sf::Texture const * m_shellTexture{ nullptr };
+
+	SteeringSnapshot m_steering;
+
+	// HUD state.
+	GameState m_gameState{ GameState::GAME_RUNNING };
+	int m_aiHealth{ 0 };
+};
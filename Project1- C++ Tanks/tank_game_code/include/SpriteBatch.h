@@ -0,0 +1,65 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+/// <summary>
+/// @brief Collects textured quads and draws them with as few draw calls as possible.
+///
+/// Sprites are transformed on the CPU and appended to one vertex array. The array is only
+///  submitted (flushed) when a quad with a different texture or blend mode arrives, when
+///  something that is not a quad is drawn through the batch, or when flush() is called.
+///  Draw order is therefore always the order of the calls, and since the world is drawn from
+///  a single sprite sheet, a whole run of sprites costs one draw call.
+/// The batch draws with whatever view the target has when it flushes, so flush before
+///  changing the view.
+/// Example usage:
+///		batch.draw(backgroundSprite);
+///		batch.draw(tankSprite);
+///		batch.draw(debugShape);		// flushes the two sprites first
+///		batch.flush();
+/// </summary>
+class SpriteBatch
+{
+public:
+	/// <summary>
+	/// @brief Creates an empty batch drawing to the given target.
+	/// </summary>
+	/// <param name="t_target">The window (or texture) to draw to, which must outlive the batch</param>
+	explicit SpriteBatch(sf::RenderTarget & t_target);
+
+	/// <summary>
+	/// @brief Adds a sprite to the batch.
+	/// </summary>
+	/// <param name="t_sprite">A sprite with a texture</param>
+	/// <param name="t_blendMode">How the sprite is blended with what is behind it</param>
+	void draw(sf::Sprite const & t_sprite, sf::BlendMode const & t_blendMode = sf::BlendAlpha);
+
+	/// <summary>
+	/// @brief Adds a quad that is already in world space to the batch.
+	/// </summary>
+	/// <param name="t_quad">Four vertices, in clockwise or anticlockwise order</param>
+	/// <param name="t_texture">The texture the texture coordinates refer to</param>
+	/// <param name="t_blendMode">How the quad is blended with what is behind it</param>
+	void drawQuad(sf::Vertex const * t_quad, sf::Texture const * t_texture, sf::BlendMode const & t_blendMode = sf::BlendAlpha);
+
+	/// <summary>
+	/// @brief Flushes the batch, then draws something that cannot be batched straight to the target.
+	/// </summary>
+	void draw(sf::Drawable const & t_drawable, sf::RenderStates const & t_states = sf::RenderStates::Default);
+
+	/// <summary>
+	/// @brief Draws everything batched so far in one draw call and empties the batch.
+	/// </summary>
+	void flush();
+
+private:
+	sf::RenderTarget & m_target;
+
+	// Two triangles per quad. Cleared, never shrunk, by flush().
+	std::vector<sf::Vertex> m_vertices;
+
+	// The state shared by everything in the batch.
+	sf::Texture const * m_texture{ nullptr };
+	sf::BlendMode m_blendMode;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// @brief A 64 bit FNV-1a hash of simulation state, for detecting when two runs diverge.
+///
+/// Values are hashed by their bit patterns, so the smallest difference in any float changes
+///  the hash. Each class folds in its own state; the order values are added in matters.
+/// Example usage:
+///		StateHash hash;
+///		hash.add(m_position);
+///		hash.add(m_health);
+///		std::uint64_t value = hash.value();
+/// </summary>
+class StateHash
+{
+public:
+	void add(float t_value) { addBytes(&t_value, sizeof(t_value)); }
+	void add(double t_value) { addBytes(&t_value, sizeof(t_value)); }
+	void add(int t_value) { addBytes(&t_value, sizeof(t_value)); }
+	void add(bool t_value) { add(t_value ? 1 : 0); }
+	void add(sf::Vector2f t_value) { add(t_value.x); add(t_value.y); }
+
+	std::uint64_t value() const { return m_value; }
+
+private:
+	void addBytes(void const * t_data, std::size_t t_size)
+	{
+		unsigned char const * bytes = static_cast<unsigned char const *>(t_data);
+		for (std::size_t i = 0; i < t_size; ++i)
+		{
+			m_value = (m_value ^ bytes[i]) * s_PRIME;
+		}
+	}
+
+	static const std::uint64_t s_OFFSET_BASIS = 14695981039346656037ull;
+	static const std::uint64_t s_PRIME = 1099511628211ull;
+
+	std::uint64_t m_value{ s_OFFSET_BASIS };
+};
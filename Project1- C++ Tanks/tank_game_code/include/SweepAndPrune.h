@@ -0,0 +1,91 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+/// <summary>
+/// @brief An incremental sweep and prune broadphase for moving objects.
+///
+/// Each moving object (tank base, turret, projectile...) owns a proxy holding its axis aligned
+///  bounding box. Once per tick the proxies are kept sorted along x by an insertion sort,
+///  which is close to O(n) because objects barely move between ticks, and a single sweep
+///  over the sorted list produces every pair whose boxes overlap.
+/// Proxies in the same group (e.g. a tank and its own shells) are never paired.
+/// Example usage:
+///		int id = sap.createProxy(sprite.getGlobalBounds(), group, kind, index);
+///		sap.setBounds(id, sprite.getGlobalBounds());	// every tick
+///		sap.update();
+///		for (SweepAndPrune::Pair const & pair : sap.pairs()) { ... }
+/// </summary>
+class SweepAndPrune
+{
+public:
+	/// <summary>
+	/// @brief Two proxies whose bounding boxes overlap. The proxy with the lower kind is always first.
+	/// </summary>
+	struct Pair
+	{
+		int m_first;
+		int m_second;
+	};
+
+	/// <summary>
+	/// @brief Adds a proxy to the broadphase.
+	/// </summary>
+	/// <param name="t_bounds">The world space bounding box of the object</param>
+	/// <param name="t_group">Proxies with the same group are never paired</param>
+	/// <param name="t_kind">Caller defined type of the object, used to order pairs</param>
+	/// <param name="t_index">Caller defined index of the object</param>
+	/// <returns>The proxy id, valid until destroyProxy() is called on it</returns>
+	int createProxy(sf::FloatRect const & t_bounds, int t_group, int t_kind, int t_index);
+
+	/// <summary>
+	/// @brief Removes a proxy. Its id may be handed out again by createProxy().
+	/// </summary>
+	void destroyProxy(int t_proxy);
+
+	/// <summary>
+	/// @brief Moves a proxy. Takes effect on the next update().
+	/// </summary>
+	void setBounds(int t_proxy, sf::FloatRect const & t_bounds);
+
+	/// <summary>
+	/// @brief Re-sorts the proxies and rebuilds the list of overlapping pairs.
+	/// </summary>
+	void update();
+
+	/// <summary>
+	/// @brief The overlapping pairs found by the last update().
+	/// </summary>
+	std::vector<Pair> const & pairs() const;
+
+	int kind(int t_proxy) const;
+	int index(int t_proxy) const;
+
+private:
+	struct Proxy
+	{
+		sf::FloatRect m_bounds;
+		int m_group;
+		int m_kind;
+		int m_index;
+	};
+
+	// The sort key is cached next to the proxy id so the insertion sort stays in one array.
+	struct Endpoint
+	{
+		float m_min;
+		int m_proxy;
+	};
+
+	// All proxies ever created, indexed by proxy id.
+	std::vector<Proxy> m_proxies;
+
+	// Ids of destroyed proxies, reused by createProxy().
+	std::vector<int> m_freeProxies;
+
+	// Live proxies, sorted by the left edge of their bounds as of the last update().
+	std::vector<Endpoint> m_sorted;
+
+	std::vector<Pair> m_pairs;
+};
@@ -1,12 +1,16 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <Thor/Resources.hpp>
 #include <iostream>
 #include "LevelLoader.h"
 #include "CollisionDetector.h"
 #include <Thor/Vectors.hpp>
 #include "ProjectilePool.h"
+#include "WallGrid.h"
 #include "MathUtility.h"
+#include "RenderSnapshot.h"
+#include "TankInput.h"
+#include "StateHash.h"
+#include "Profiler.h"
 
 
 /// <summary>
@@ -20,18 +24,49 @@ public:
 
 	const double MAX_REVERSE_SPEED = -100;
 	const double MAX_FORWARD_SPEED = 100;
+	// Speed gained per second while accelerating or braking.
+	const double ACCELERATION = 60;
+	// Degrees per second the base and the turret turn at.
+	const double ROTATION_SPEED = 60;
+	const double TURRET_ROTATION_SPEED = 60;
+	// The fraction of its speed the tank keeps every FRICTION_STEP_MS, i.e. every 1/60 s, the
+	//  step the game was tuned at. It is applied as pow(FRICTION, dt / FRICTION_STEP_MS), so the
+	//  tank slows down the same whatever the tick rate.
 	const double FRICTION = 0.99;
+	const double FRICTION_STEP_MS = 1000.0 / 60.0;
 
 	enum class TankState {NORMAL, COLLIDING};
 
 	/// <summary> /// @brief Constructor that stores drawable state (texture, sprite) for the tank. 
-    /// Stores references to the resource holder and container of wall sprites. /// Creates sprites for the tank base and turret from the texture in the resource holder. 
+    /// Stores references to the container of wall sprites. /// Creates sprites for the tank base and turret from the sprite sheet texture. 
 	/// /// </summary> 
-/// <param name="t_holder">A reference to the resource holder</param> ///< param name="t_wallSprites">A reference to the container of wall
+/// <param name="t_texture">The sprite sheet texture, or nullptr when headless</param> ///< param name="t_wallSprites">A reference to the container of wall
 /// sprites </param>
-	Tank(thor::ResourceHolder <sf::Texture, std::string> & t_holder, std::vector<sf::Sprite>& t_wallSprites);
-	void update(double dt, sf::Sprite t_base, std::function<void(int)> t_funcApplyDamage);
-	void render(sf::RenderWindow & window);
+/// <param name="t_wallGrid">A reference to the broadphase grid built over the wall sprites</param>
+	Tank(sf::Texture const * t_texture, std::vector<sf::Sprite>& t_wallSprites, WallGrid const & t_wallGrid);
+
+/// <summary>
+/// @brief Moves the tank one tick, steered by the given controls.
+/// </summary>
+/// <param name="dt">update delta time</param>
+/// <param name="t_input">The controls held down this tick</param>
+	void update(double dt, TankInput const & t_input);
+
+/// <summary>
+/// @brief Remembers the current transforms of the base, turret and shells, as the start of
+///  the next tick for render interpolation. Called at the start of every simulation tick.
+/// </summary>
+	void storePreviousState();
+
+/// <summary>
+/// @brief Copies the previous and current base and turret into a render snapshot.
+/// </summary>
+	void snapshot(TankSnapshot & t_snapshot) const;
+
+/// <summary>
+/// @brief Adds the movement, turret and weapon state of the tank and its shells to a state hash.
+/// </summary>
+	void hash(StateHash & t_hash) const;
 	void setPosition(sf::Vector2f t_position);
 	sf::Vector2f getPosition() const;
 
@@ -42,54 +77,64 @@ public:
 	// Const versions of the getter declarations
 	const sf::Sprite& getTurret() const;
 	const sf::Sprite& getBase() const;
+
+	// The shells fired by this tank
+	ProjectilePool& getProjectiles();
+	const ProjectilePool& getProjectiles() const;
 /// <summary>
-/// @brief Increase the speed by 1
+/// @brief Increase the speed by ACCELERATION per second
 /// </summary>
-	void increaseSpeed();
+/// <param name="dt">update delta time</param>
+	void increaseSpeed(double dt);
 
 /// <summary>
-/// @brief Decrease the speed by 1
+/// @brief Decrease the speed by ACCELERATION per second
 /// </summary>
-	void decreaseSpeed();
+/// <param name="dt">update delta time</param>
+	void decreaseSpeed(double dt);
 
 /// <summary>
-/// @brief increase the rotation of the tank base by 1 degree, wraps to 0 after 359
+/// @brief increase the rotation of the tank base by ROTATION_SPEED degrees per second, wraps to 0 at 360
 /// </summary>
-	void increaseRotation();
+/// <param name="dt">update delta time</param>
+	void increaseRotation(double dt);
 
 /// <summary>
-/// @brief increase the rotation of the tank base by 1 degree, wraps to 359 after 0
+/// @brief decrease the rotation of the tank base by ROTATION_SPEED degrees per second, wraps to 360 below 0
 /// </summary>
-	void decreaseRotation();
+/// <param name="dt">update delta time</param>
+	void decreaseRotation(double dt);
 
 	void requestFire();
 
 /// <summary>
-/// @brief this function will be used to handle the keyboard events now instead of in game.cpp
-/// 	constantly polls keyboard and uses a switch to trigger events off key inputs
+/// @brief this function will be used to handle the player controls now instead of in game.cpp
+/// 	checks every control of this tick's input and triggers events off them
 /// 	allows for multiple inputs at once
 /// </summary>
-	void handleKeyInput();
+	void handleInput(TankInput const & t_input, double dt);
 
 /// <summary>
-/// @ Increases the rotation of the turret by 1 degree
+/// @ Increases the rotation of the turret by TURRET_ROTATION_SPEED degrees per second
 /// </summary>
-	void increaseTurretRotation();
+	void increaseTurretRotation(double dt);
 
 /// <summary>
-/// @brief Decreases the rotation of the turret by 1 degree
+/// @brief Decreases the rotation of the turret by TURRET_ROTATION_SPEED degrees per second
 /// </summary>
-	void decreaseTurretRotation();
+	void decreaseTurretRotation(double dt);
 
 
 /// <summary>
-/// @brief Recenter the turret on the tank
+/// @brief Recenter the turret on the tank, turning it by m_recentreTurretSpeed degrees per second
 /// </summary>
-	bool centreTurret();
+/// <param name="dt">update delta time</param>
+/// <returns>True while the turret is still recentering</returns>
+	bool centreTurret(double dt);
 
 /// <summary>
 /// @brief Checks for collisions between the tank and walls
-/// 
+/// Only the walls in the grid cells overlapped by the tank base and turret are tested.
 /// </summary>
 /// <returns> True if a collision is detected between tank and wall </returns>
 	bool checkWallCollision();
@@ -106,7 +151,11 @@ private:
 	ProjectilePool m_Pool;
 	sf::Sprite m_tankBase;
 	sf::Sprite m_turret;
-	thor::ResourceHolder<sf::Texture, std::string> & m_holder;
+	// The base and turret transforms at the start of the last tick.
+	sf::Transformable m_previousBase;
+	sf::Transformable m_previousTurret;
+	// The sprite sheet texture, nullptr when headless.
+	sf::Texture const * m_texture;
 	// Load the game level data
 	LevelData m_level;
 
@@ -119,8 +168,8 @@ private:
 	// The current rotation as applied to the tank base
 	double m_turretRotation{ 0.0 };
 
-	// The speed at which the turret recenters at 
-	double m_recentreTurretSpeed = 1.0;
+	// The speed at which the turret recenters at, in degrees per second
+	double m_recentreTurretSpeed = 60.0;
 	
 	// This variable will control the direction the turret returns to center at ensuring it takes the shortest path
 	int direction = 0;
@@ -128,6 +177,13 @@ private:
 	// A reference to the container of wall sprites. 
 	std::vector<sf::Sprite> & m_wallSprites;
 
+	// A reference to the broadphase grid over the wall sprites.
+	WallGrid const & m_wallGrid;
+
+	// Scratch space for the batched turret/base versus wall SAT results.
+	std::vector<std::uint8_t> m_turretHits;
+	std::vector<std::uint8_t> m_baseHits;
+
 	// Vector to store the data related to the difference in position between the tank and walls, also the angle between them
 	sf::Vector2f m_contactNormal;
 
@@ -136,5 +192,5 @@ private:
 
 	bool m_fireRequested = false; 
 	double m_shootTimer = 0.5; // Example timer value    
-	static constexpr double s_TIME_BETWEEN_SHOTS = 800; // Time between shots   };
+	double m_reloadTime = 800; // Time between shots in milliseconds, read from the level weapon data
 };
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+/// <summary>
+/// @brief The player tank's controls for one simulation tick, one bit per control.
+///
+/// The simulation never reads a device itself: each tick it is handed a TankInput, read from
+///  the keyboard when playing and from an InputScript when running headless.
+/// </summary>
+struct TankInput
+{
+	enum Control : std::uint8_t
+	{
+		ACCELERATE = 1 << 0,
+		BRAKE = 1 << 1,
+		TURN_LEFT = 1 << 2,
+		TURN_RIGHT = 1 << 3,
+		TURRET_LEFT = 1 << 4,
+		TURRET_RIGHT = 1 << 5,
+		CENTRE_TURRET = 1 << 6,
+		FIRE = 1 << 7
+	};
+
+	// The controls held down this tick.
+	std::uint8_t m_controls{ 0 };
+
+	bool isDown(Control t_control) const
+	{
+		return (m_controls & t_control) != 0;
+	}
+
+	void press(Control t_control)
+	{
+		m_controls |= t_control;
+	}
+
+	/// <summary>
+	/// @brief Reads every control from the keyboard.
+	/// </summary>
+	static TankInput fromKeyboard();
+
+	/// <summary>
+	/// @brief Returns the control with the given name, e.g. "FIRE", or 0 if there is none.
+	/// </summary>
+	static std::uint8_t controlNamed(char const * t_name);
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+/// <summary>
+/// @brief A lock-free triple buffer handing values from one writer thread to one reader thread.
+///
+/// The writer fills back() and publish()es it; the reader calls acquire() to get the most
+///  recently published value. Neither side ever waits for the other: the writer always has a
+///  buffer of its own to fill, the reader keeps the buffer it acquired until it acquires again,
+///  and the third buffer holds the latest published value in between. Values published while
+///  the reader is busy are simply replaced, so the reader only ever sees the newest one.
+/// Buffers are reused, never reallocated, so a T holding containers stops allocating once
+///  each buffer has been filled a few times.
+/// Example usage:
+///		// Writer thread
+///		buffer.back() = makeValue();
+///		buffer.publish();
+///		// Reader thread
+///		T const & value = buffer.acquire();
+/// </summary>
+template <typename T>
+class TripleBuffer
+{
+public:
+	/// <summary>
+	/// @brief Returns the buffer the writer fills next. Writer thread only.
+	/// </summary>
+	T & back()
+	{
+		return m_buffers[m_back];
+	}
+
+	/// <summary>
+	/// @brief Makes the back buffer the latest value and gives the writer another buffer to fill.
+	/// Writer thread only.
+	/// </summary>
+	void publish()
+	{
+		m_back = m_middle.exchange(m_back | s_NEW_VALUE, std::memory_order_acq_rel) & s_INDEX_MASK;
+	}
+
+	/// <summary>
+	/// @brief Returns the latest published value, which stays valid and unchanged until the next
+	///  call. If nothing was published since the last call, returns the same value again.
+	/// Reader thread only.
+	/// </summary>
+	T const & acquire()
+	{
+		if (m_middle.load(std::memory_order_relaxed) & s_NEW_VALUE)
+		{
+			m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & s_INDEX_MASK;
+		}
+		return m_buffers[m_front];
+	}
+
+private:
+	// The middle index carries a flag saying whether it was published since the reader last took it.
+	static const int s_INDEX_MASK = 3;
+	static const int s_NEW_VALUE = 4;
+
+	std::array<T, 3> m_buffers;
+
+	// Owned by the reader.
+	int m_front{ 0 };
+
+	// Shared, holding the latest value.
+	std::atomic<int> m_middle{ 1 };
+
+	// Owned by the writer.
+	int m_back{ 2 };
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "OrientedBoundingBox.h"
+
+/// <summary>
+/// @brief A uniform grid broadphase for the static wall sprites.
+///
+/// Walls never move once World::generateWalls() has run, so the grid is built once
+///  and then queried by anything that needs to test against walls. Each wall is
+///  binned into the single cell containing its centre, and queries are widened by the
+///  largest wall half-extent, so every wall a collider could touch is visited exactly once.
+/// The grid also keeps a StaticCollider per wall, so the narrowphase never has to rebuild
+///  the bounding box of a wall either, and a copy of them in an ObbBatch stored in cell
+///  order ("slots"), so the walls of a span of cells can be tested with one collideBatch() call.
+/// Example usage:
+///		sf::IntRect cells = grid.cellRange(sprite.getGlobalBounds());
+///		grid.forEachInCells(cells, [&](int t_index) { ...; return false; });
+/// </summary>
+class WallGrid
+{
+public:
+	/// <summary>
+	/// @brief Creates an empty grid.
+	/// </summary>
+	/// <param name="t_cellSize">The width and height of a single grid cell in world units</param>
+	explicit WallGrid(float t_cellSize = 64.0f);
+
+	/// <summary>
+	/// @brief Bins every wall sprite into the grid and bakes its collider, discarding any previous contents.
+	/// Wall indices reported by the queries are indices into t_wallSprites.
+	/// </summary>
+	/// <param name="t_wallSprites">The container of wall sprites</param>
+	void build(std::vector<sf::Sprite> const & t_wallSprites);
+
+	/// <summary>
+	/// @brief Returns the range of cells that may hold a wall overlapping the given bounds.
+	/// The range is clamped to the grid; an empty range (zero width or height) means no wall can overlap.
+	/// </summary>
+	/// <param name="t_bounds">A world space axis aligned bounding box</param>
+	/// <returns>The first column/row and the number of columns/rows to visit</returns>
+	sf::IntRect cellRange(sf::FloatRect const & t_bounds) const;
+
+	/// <summary>
+	/// @brief Calls t_func with the index of each wall binned in the given cell range.
+	/// The visit stops early as soon as t_func returns true.
+	/// </summary>
+	/// <param name="t_cells">A cell range as returned by cellRange()</param>
+	/// <param name="t_func">A callable taking an int wall index and returning bool</param>
+	/// <returns>True if t_func returned true for any wall</returns>
+	template <typename Func>
+	bool forEachInCells(sf::IntRect const & t_cells, Func t_func) const;
+
+	/// <summary>
+	/// @brief Convenience wrapper for forEachInCells(cellRange(t_bounds), t_func).
+	/// </summary>
+	template <typename Func>
+	bool forEachNear(sf::FloatRect const & t_bounds, Func t_func) const;
+
+	/// <summary>
+	/// @brief Calls t_func once per row of the cell range with the span of batch slots [first, last)
+	///  holding the walls of that row. Empty spans are skipped.
+	/// The visit stops early as soon as t_func returns true.
+	/// </summary>
+	/// <param name="t_cells">A cell range as returned by cellRange()</param>
+	/// <param name="t_func">A callable taking two int slots and returning bool</param>
+	/// <returns>True if t_func returned true for any span</returns>
+	template <typename Func>
+	bool forEachSpanInCells(sf::IntRect const & t_cells, Func t_func) const;
+
+	/// <summary>
+	/// @brief Returns the number of walls held in the grid.
+	/// </summary>
+	int wallCount() const;
+
+	/// <summary>
+	/// @brief Returns the precomputed bounding box of a wall.
+	/// </summary>
+	/// <param name="t_wall">A wall index, as passed to the query callbacks</param>
+	StaticCollider const & collider(int t_wall) const;
+
+	/// <summary>
+	/// @brief Returns the wall index held in a batch slot.
+	/// </summary>
+	int wallAt(int t_slot) const;
+
+	/// <summary>
+	/// @brief Returns the colliders of all walls, in slot order.
+	/// </summary>
+	ObbBatch const & batch() const;
+
+private:
+	// The width and height of one cell.
+	float m_cellSize;
+
+	// The world position of the top left corner of cell (0,0).
+	sf::Vector2f m_origin;
+
+	int m_columns{ 0 };
+	int m_rows{ 0 };
+
+	// The largest distance from a wall centre to the edge of its bounding box.
+	float m_maxHalfExtent{ 0.0f };
+
+	// Offsets into m_walls, one per cell plus a terminating entry (compressed row storage).
+	std::vector<int> m_cellStart;
+
+	// Wall indices, grouped by cell in row major order.
+	std::vector<int> m_walls;
+
+	// One collider per wall, indexed like the wall sprites.
+	std::vector<StaticCollider> m_colliders;
+
+	// The same colliders in slot order, i.e. m_batch box i is wall m_walls[i].
+	ObbBatch m_batch;
+};
+
+////////////////////////////////////////////////////////////
+template <typename Func>
+bool WallGrid::forEachInCells(sf::IntRect const & t_cells, Func t_func) const
+{
+	for (int row = t_cells.top; row < t_cells.top + t_cells.height; ++row)
+	{
+		// Cells in a row are adjacent, so the walls of the whole span are contiguous.
+		int first = m_cellStart[row * m_columns + t_cells.left];
+		int last = m_cellStart[row * m_columns + t_cells.left + t_cells.width];
+		for (int i = first; i < last; ++i)
+		{
+			if (t_func(m_walls[i]))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+template <typename Func>
+bool WallGrid::forEachSpanInCells(sf::IntRect const & t_cells, Func t_func) const
+{
+	for (int row = t_cells.top; row < t_cells.top + t_cells.height; ++row)
+	{
+		int first = m_cellStart[row * m_columns + t_cells.left];
+		int last = m_cellStart[row * m_columns + t_cells.left + t_cells.width];
+		if (first < last && t_func(first, last))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+template <typename Func>
+bool WallGrid::forEachNear(sf::FloatRect const & t_bounds, Func t_func) const
+{
+	return forEachInCells(cellRange(t_bounds), t_func);
+}
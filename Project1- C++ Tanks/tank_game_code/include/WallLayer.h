@@ -0,0 +1,106 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+/// <summary>
+/// @brief Draws the static wall sprites from vertex buffers held on the GPU.
+///
+/// The level is cut into square chunks of world space, and every wall is binned into the
+///  chunk containing its centre. The transformed quads of the walls of a chunk are baked once
+///  into an sf::VertexBuffer with static usage, so drawing the whole level costs one draw call
+///  per visible chunk instead of one per wall, and no vertex is uploaded again unless a wall changes.
+/// A chunk whose walls change is marked dirty and rebuilt the next time it is drawn.
+/// If the driver has no vertex buffer support, the same vertices are drawn from memory instead.
+/// Example usage:
+///		layer.build(wallSprites);
+///		layer.render(window);
+/// </summary>
+class WallLayer
+{
+public:
+	/// <summary>
+	/// @brief Creates an empty layer.
+	/// </summary>
+	/// <param name="t_chunkSize">The width and height of a single chunk in world units</param>
+	explicit WallLayer(float t_chunkSize = 512.0f);
+
+	/// <summary>
+	/// @brief Bins every wall sprite into a chunk, discarding any previous contents.
+	/// The sprites are referenced, not copied, and must outlive the layer. All walls are
+	///  assumed to share one texture.
+	/// </summary>
+	/// <param name="t_wallSprites">The container of wall sprites</param>
+	void build(std::vector<sf::Sprite> const & t_wallSprites);
+
+	/// <summary>
+	/// @brief Tells the layer a wall sprite was moved, rotated or retextured.
+	/// The chunk holding the wall (and the chunk it moved into, if different) is rebuilt
+	///  the next time it is drawn.
+	/// </summary>
+	/// <param name="t_wall">An index into the wall sprites passed to build()</param>
+	void wallChanged(int t_wall);
+
+	/// <summary>
+	/// @brief Draws every chunk overlapping the current view of the render target.
+	/// </summary>
+	/// <param name="t_target">The window (or texture) to draw to</param>
+	void render(sf::RenderTarget & t_target);
+
+	/// <summary>
+	/// @brief Returns the number of draw calls made by the last render().
+	/// </summary>
+	int drawCalls() const;
+
+private:
+	/// <summary>
+	/// @brief A square region of the level and the walls binned into it.
+	/// </summary>
+	struct Chunk
+	{
+		// The wall indices binned into this chunk.
+		std::vector<int> m_walls;
+
+		// The union of the bounds of the walls, used for culling.
+		sf::FloatRect m_bounds;
+
+		// The baked wall quads, as two triangles each.
+		std::vector<sf::Vertex> m_vertices;
+		sf::VertexBuffer m_buffer{ sf::Triangles, sf::VertexBuffer::Static };
+
+		// True when m_vertices and m_buffer no longer match the walls.
+		bool m_dirty{ true };
+	};
+
+	/// <summary>
+	/// @brief Returns the index of the chunk containing a world position, clamped to the layer.
+	/// </summary>
+	int chunkAt(sf::Vector2f t_position) const;
+
+	/// <summary>
+	/// @brief Bakes the quads of every wall in a chunk and uploads them.
+	/// </summary>
+	void rebuild(Chunk & t_chunk);
+
+	// The width and height of one chunk.
+	float m_chunkSize;
+
+	// The world position of the top left corner of chunk (0,0).
+	sf::Vector2f m_origin;
+
+	int m_columns{ 0 };
+	int m_rows{ 0 };
+
+	// Chunks in row major order.
+	std::vector<Chunk> m_chunks;
+
+	// The chunk each wall is currently binned into.
+	std::vector<int> m_wallChunk;
+
+	std::vector<sf::Sprite> const * m_wallSprites{ nullptr };
+
+	// Walls are drawn with the texture of the first wall.
+	sf::Texture const * m_texture{ nullptr };
+
+	int m_drawCalls{ 0 };
+};
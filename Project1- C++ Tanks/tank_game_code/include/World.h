@@ -0,0 +1,156 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <Thor/Resources.hpp>
+#include <string>
+#include <vector>
+#include "LevelLoader.h"
+#include "Tank.h"
+#include "AITank.h"
+#include "GameState.h"
+#include "WallGrid.h"
+#include "SweepAndPrune.h"
+#include "HitEventQueue.h"
+#include "RenderSnapshot.h"
+#include "TankInput.h"
+#include "StateHash.h"
+#include "Profiler.h"
+#include <cstdint>
+
+/// <summary>
+/// @brief Everything the game simulates: the level, the walls, both tanks and their shells,
+///  the broadphase and the game state.
+///
+/// A World never opens a window, loads a font or touches the GPU, so the same simulation is
+///  run by Game, which draws it, and by HeadlessRunner, which only steps it. When headless
+///  the sprites have no texture at all, only texture rects, which is all the simulation
+///  needs of them; collision masks are baked from the atlas image instead.
+/// Example usage:
+///		World world(World::loadAtlas(nullptr));
+///		world.update(dt, input);
+/// </summary>
+class World
+{
+public:
+	// The default number of simulation updates per second, and the range allowed.
+	// Below the minimum a tank moves too far in one tick for its wall collision to be
+	//  believable; above the maximum a tick is shorter than the timers can usefully resolve.
+	static constexpr double s_DEFAULT_TICK_RATE{ 60.0 };
+	static constexpr double s_MIN_TICK_RATE{ 10.0 };
+	static constexpr double s_MAX_TICK_RATE{ 1000.0 };
+
+	/// <summary>
+	/// @brief Loads level 1 and builds the walls, the tanks and the broadphase.
+	/// </summary>
+	/// <param name="t_atlas">The sprite sheet texture, or nullptr when headless</param>
+	explicit World(sf::Texture const * t_atlas);
+
+	/// <summary>
+	/// @brief Loads the sprite sheet image and bakes its collision masks. Call once before
+	///  creating a World. If a resource holder is given the texture is created in it as
+	///  "tankAtlas", otherwise (headless) no texture is created.
+	/// </summary>
+	/// <param name="t_holder">The resource holder for the texture, or nullptr when headless</param>
+	/// <returns>The sprite sheet texture, or nullptr when headless</returns>
+	static sf::Texture const * loadAtlas(thor::ResourceHolder<sf::Texture, std::string> * t_holder);
+
+	/// <summary>
+	/// @brief Advances the simulation by one tick.
+	/// At the start of the tick every moving object remembers its state, for render interpolation.
+	/// </summary>
+	/// <param name="dt">update delta time</param>
+	/// <param name="t_input">The player's controls for this tick</param>
+	void update(double dt, TankInput const & t_input);
+
+	/// <summary>
+	/// @brief Fills a render snapshot with the state of the last tick.
+	/// Everything but the publish time is set.
+	/// </summary>
+	void snapshot(RenderSnapshot & t_snapshot) const;
+
+	/// <summary>
+	/// @brief Returns a hash of every piece of simulation state a tick depends on.
+	/// Two runs of the same level with the same inputs hash the same after every tick;
+	///  the first tick they differ is where they diverged.
+	/// </summary>
+	std::uint64_t stateHash() const;
+
+	GameState getGameState() const;
+
+	std::vector<sf::Sprite> const & walls() const;
+
+	/// <summary>
+	/// @brief Returns the area the tanks and shells move in.
+	/// </summary>
+	sf::FloatRect bounds() const;
+
+private:
+	/// <summary>
+	/// @brief Creates the wall sprites and loads them into a vector.
+	/// /// Note that sf::Sprite is considered a light weight class, so
+	/// /// storing copies (instead of pointers to sf::Sprite) in std::vector /// is acceptable.
+	/// The wall broadphase grid is built once all walls have been created.
+	/// </summary>
+	void generateWalls();
+
+	/// <summary>
+	/// @brief Creates the broadphase proxies for the tank bases and turrets.
+	/// </summary>
+	void initBroadphase();
+
+	/// <summary>
+	/// @brief Moves every broadphase proxy to its object's current bounds, creates and destroys
+	///  proxies for shells that were fired or retired since the last tick, then finds the
+	///  overlapping pairs and responds to them.
+	/// </summary>
+	void updateBroadphase();
+
+	void setGameState(GameState newState);
+
+	// The sprite sheet texture, nullptr when headless.
+	sf::Texture const * m_atlas;
+
+	LevelData m_level;
+	std::vector<sf::Sprite> m_wallSprites;
+	// Broadphase grid over m_wallSprites, built once in generateWalls().
+	WallGrid m_wallGrid;
+	Tank m_tank;
+	AITank m_aiTank;
+	GameState m_currentGameState{ GameState::GAME_RUNNING }; // Store the current game state
+
+	// Set when the centre turret control is pressed, and cleared once the turret is centred.
+	bool m_centringTurret{ false };
+
+	// The map is the size of the background.
+	sf::FloatRect m_bounds{ 0.0f, 0.0f, 2000.0f, 1500.0f };
+
+	// Hits detected this tick, handled and cleared at the end of update().
+	HitEventQueue m_hits;
+
+	// The kinds of moving object in the broadphase. Pairs always list the lower kind first.
+	enum BodyKind
+	{
+		PLAYER_BASE,
+		PLAYER_TURRET,
+		PLAYER_SHELL,
+		AI_BASE,
+		AI_TURRET
+	};
+
+	// Broadphase groups; a tank never collides with its own turret or shells.
+	static const int s_PLAYER_GROUP = 0;
+	static const int s_AI_GROUP = 1;
+
+	// Broadphase over all moving objects.
+	SweepAndPrune m_broadphase;
+	int m_playerBaseProxy{ -1 };
+	int m_playerTurretProxy{ -1 };
+	int m_aiBaseProxy{ -1 };
+	int m_aiTurretProxy{ -1 };
+
+	// Proxy per player projectile pool slot, -1 while the slot is not in flight.
+	std::vector<int> m_shellProxies;
+
+	// The pool slots that currently have a proxy, so retired shells are found without visiting every slot.
+	std::vector<int> m_trackedShells;
+};
@@ -1,7 +1,9 @@
 #include "AITank.h"
+#include <algorithm>
+#include <cmath>
 
 ////////////////////////////////////////////////////////////
-AITank::AITank(sf::Texture const & texture, std::vector<sf::Sprite> & wallSprites)
+AITank::AITank(sf::Texture const * texture, std::vector<sf::Sprite> & wallSprites)
 	: m_aiBehaviour(AiBehaviour::SEEK_PLAYER)
 	, m_texture(texture)
 	, m_wallSprites(wallSprites)
@@ -16,16 +18,19 @@ AITank::AITank(sf::Texture const & texture, std::vector<sf::Sprite> & wallSprite
 ////////////////////////////////////////////////////////////
 void AITank::update(Tank const & playerTank, double dt)
 {
+	PROFILE_SCOPE(ProfileZone::AI_UPDATE);
 
 	sf::Vector2f vectorToPlayer = seek(playerTank.getPosition());	
+	// The steering forces are per STEERING_STEP_MS, so scale them to this tick
+	float steps = static_cast<float>(dt / STEERING_STEP_MS);
 	switch (m_aiBehaviour)
 	{
 	case AiBehaviour::SEEK_PLAYER:
-		m_steering += thor::unitVector(vectorToPlayer);
-		m_steering += collisionAvoidance();
+		m_steering += thor::unitVector(vectorToPlayer) * steps;
+		m_steering += collisionAvoidance() * steps;
 	//	std::cout << "Updated Steering: " << m_steering.x << ", " << m_steering.y << std::endl;
 		m_steering = MathUtility::truncate(m_steering, MAX_FORCE);
-		m_velocity = MathUtility::truncate(m_velocity + m_steering, MAX_SPEED);
+		m_velocity = MathUtility::truncate(m_velocity + m_steering * steps, MAX_SPEED);
 		break;
 
 	case AiBehaviour::STOP:
@@ -42,23 +47,27 @@ void AITank::update(Tank const & playerTank, double dt)
 	auto dest = atan2(-1 * m_velocity.y, -1 * m_velocity.x) / std::numbers::pi * 180 + 180;
 
 	auto currentRotation = m_rotation;
+	double step = ROTATION_SPEED * (dt / 1000);
+
+	// The signed difference from the current rotation to the destination, within -180 to 180 degrees
+	double difference = std::fmod(dest - currentRotation + 540.0, 360.0) - 180.0;
 
 	// Find the shortest way to rotate towards the player (clockwise or anti-clockwise)
-	if (std::round(currentRotation - dest) == 0.0)
+	if (std::abs(difference) < std::max(0.5, step / 2))
 	{
 		m_steering.x = 0;
 		m_steering.y = 0;
 	}
 
-	else if ((static_cast<int>(std::round(dest - currentRotation + 360))) % 360 < 180)
+	else if (difference > 0)
 	{
 		// rotate clockwise
-		m_rotation = static_cast<int>((m_rotation) + 1) % 360;
+		m_rotation = std::fmod(m_rotation + step, 360.0);
 	}
 	else
 	{
 		// rotate anti-clockwise
-		m_rotation = static_cast<int>((m_rotation) - 1) % 360;
+		m_rotation = std::fmod(m_rotation - step + 360.0, 360.0);
 	}
 
 
@@ -72,33 +81,38 @@ void AITank::update(Tank const & playerTank, double dt)
 	}
 
 	updateMovement(dt);
-	//checkProjectileCollision(projectiles,  gameState);
 }
 
 ////////////////////////////////////////////////////////////
-void AITank::render(sf::RenderWindow & window)
+void AITank::snapshot(TankSnapshot & t_tank, SteeringSnapshot & t_steering) const
 {
-	// TODO: Don't draw if off-screen...
-	window.draw(m_tankBase);
-	window.draw(m_turret);
-	window.draw(m_aheadVector);
-	window.draw(m_aheadLeftVector);
-	window.draw(m_aheadRightVector);
-	window.draw(healthText);
-
-	for (sf::CircleShape& obs : m_obstacles)
+	t_tank.m_base = m_tankBase;
+	t_tank.m_turret = m_turret;
+	t_tank.m_previousBase = m_previousBase;
+	t_tank.m_previousTurret = m_previousTurret;
+
+	t_steering.m_position = m_tankBase.getPosition();
+	t_steering.m_ahead = m_ahead;
+	t_steering.m_aheadLeft = m_aheadLeft;
+	t_steering.m_aheadRight = m_aheadRight;
+	t_steering.m_mostThreatening = m_mostThreatening != nullptr
+		? static_cast<int>(m_mostThreatening - m_obstacles.data()) : -1;
+
+	if (t_steering.m_obstacles.size() != m_obstacles.size())
 	{
-		if (&obs == m_mostThreatening && m_mostThreatening != nullptr)
-		{
-			obs.setFillColor(sf::Color::Red);
-		}
-		else
+		t_steering.m_obstacles.clear();
+		for (sf::CircleShape const & obstacle : m_obstacles)
 		{
-			obs.setFillColor(sf::Color(255, 255, 255, 63));
+			t_steering.m_obstacles.push_back(ObstacleSnapshot{ obstacle.getPosition(), obstacle.getRadius() });
 		}
-		window.draw(obs);
 	}
+}
 
+////////////////////////////////////////////////////////////
+void AITank::storePreviousState()
+{
+	m_previousBase = m_tankBase;
+	m_previousTurret = m_turret;
 }
 
 ////////////////////////////////////////////////////////////
@@ -107,7 +121,6 @@ void AITank::init(sf::Vector2f t_position, sf::Vector2f t_scale)
 
 	sf::IntRect brownTankRect(0, 138, 244, 114);
 
-	m_tankBase.setTexture(m_texture);
 	m_tankBase.setPosition(t_position);
 	m_tankBase.setScale(t_scale.x, t_scale.y);
 	for (sf::Sprite const wallSprite : m_wallSprites)
@@ -119,32 +132,31 @@ void AITank::init(sf::Vector2f t_position, sf::Vector2f t_scale)
 	}
 	sf::IntRect turretRect(0, 253, 212, 94);
 
-	m_turret.setTexture(m_texture);
 	m_turret.setPosition(t_position);
 	m_turret.setScale(t_scale.x, t_scale.y);
-
-	//m_gameStateText.setFont(hudFont);
-	//m_gameStateText.setCharacterSize(30);
-	//m_gameStateText.setFillColor(sf::Color::Blue);
-	//m_gameStateText.setString("Game Running");
-	//m_gameStateText.setPosition(sf::Vector2f(600 - m_gameStateText.getGlobalBounds().width / 2.0f, 5));
-	if (!m_arialFont.loadFromFile("BebasNeue.otf"))
-	{
-		std::cout << "Error loading font file";
-	}
-	healthText.setFont(m_arialFont);
-	healthText.setCharacterSize(30);
-	healthText.setFillColor(sf::Color::Red);
-	healthText.setString("health : " + std::to_string(m_health));
-	healthText.setPosition(20, 5);
+	storePreviousState();
 }
 
 
 sf::Vector2f AITank::filterOutput(sf::Vector2f input, float alpha) 
 {
-	static sf::Vector2f previousOutput = sf::Vector2f(0, 0);
-	previousOutput = alpha * previousOutput + (1.0f - alpha) * input;
-	return previousOutput;
+	m_filteredOutput = alpha * m_filteredOutput + (1.0f - alpha) * input;
+	return m_filteredOutput;
+}
+
+////////////////////////////////////////////////////////////
+void AITank::hash(StateHash & t_hash) const
+{
+	t_hash.add(m_tankBase.getPosition());
+	t_hash.add(m_tankBase.getRotation());
+	t_hash.add(m_turret.getPosition());
+	t_hash.add(m_turret.getRotation());
+	t_hash.add(m_rotation);
+	t_hash.add(m_velocity);
+	t_hash.add(m_steering);
+	t_hash.add(m_filteredOutput);
+	t_hash.add(static_cast<int>(m_aiBehaviour));
+	t_hash.add(m_health);
 }
 
 bool AITank::collidesWithPlayer(Tank const& playerTank) const
@@ -169,6 +181,11 @@ sf::Sprite& AITank::getBase()
 	// TODO: insert return statement here
 }
 
+const sf::Sprite& AITank::getTurret() const
+{
+	return m_turret;
+}
+
 
 ////////////////////////////////////////////////////////////
 sf::Vector2f AITank::seek(sf::Vector2f t_playerPosition) const
@@ -190,27 +207,6 @@ sf::Vector2f AITank::collisionAvoidance()
 	m_aheadLeft = m_tankBase.getPosition() + thor::rotatedVector(headingVector * 0.5f, 45.0f);
 	m_aheadRight = m_tankBase.getPosition() + thor::rotatedVector(headingVector * 0.5f, -45.0f);
 
-	// Setup debug visualization lines
-	// Straight ahead vector
-	m_aheadVector.setPosition(m_tankBase.getPosition());
-	m_aheadVector.setSize({ thor::length(headingVector), 1.0f });
-	m_aheadVector.setFillColor(sf::Color::Red);
-	m_aheadVector.setRotation(m_rotation);
-
-	// Left ahead vector
-	sf::Vector2f leftVec = thor::rotatedVector(headingVector * 0.5f, -45.0f);
-	m_aheadLeftVector.setPosition(m_tankBase.getPosition());
-	m_aheadLeftVector.setSize({ thor::length(leftVec), 1.0f });
-	m_aheadLeftVector.setFillColor(sf::Color::Green);
-	m_aheadLeftVector.setRotation(m_rotation + 45.f);
-
-	// Right ahead vector
-	sf::Vector2f rightVec = thor::rotatedVector(headingVector * 0.5f, 45.0f);
-	m_aheadRightVector.setPosition(m_tankBase.getPosition());
-	m_aheadRightVector.setSize({ thor::length(rightVec), 1.0f });
-	m_aheadRightVector.setFillColor(sf::Color::Blue);
-	m_aheadRightVector.setRotation(m_rotation - 45.0f);
-
 	sf::Vector2f collisionVector = findMostThreateningObstacle();
 
 	sf::Vector2f avoidance(0.f, 0.f);
@@ -228,7 +224,7 @@ sf::Vector2f AITank::collisionAvoidance()
 	avoidance.y = std::lerp(m_steering.y, avoidance.y, 0.9);
 
 
-	std::cout << "Avoidance Vector: " << avoidance.x << ", " << avoidance.y << std::endl;
+	Logger::log(LogLevel::TRACE, LogCategory::AI, "Avoidance Vector: {}, {}", avoidance.x, avoidance.y);
 
 	return avoidance;
 }
@@ -254,7 +250,7 @@ sf::Vector2f  AITank::findMostThreateningObstacle()
 
 		if (collidesAheadFull)
 		{
-			std::cout << "There is a collision!";
+			Logger::log(LogLevel::DEBUG, LogCategory::AI, "There is a collision!");
 			collisionVector = m_ahead;
 		}
 		else if (collidesAheadLeft)
@@ -297,14 +293,18 @@ void AITank::initSprites()
 	// BrownTank,0,138,244,114
 	// Gun_01_Brown,0,253,212,94
 	sf::IntRect brownTankRect(481, 1501, 246, 114);
-	m_tankBase.setTexture(m_texture);
+	// Headless sprites have no texture; their texture rects still give them their size.
+	if (m_texture != nullptr)
+	{
+		m_tankBase.setTexture(*m_texture);
+		m_turret.setTexture(*m_texture);
+	}
 	m_tankBase.setTextureRect(brownTankRect);
 
 	m_tankBase.setOrigin(88, brownTankRect.height / 2.0);
 	m_tankBase.setPosition(sf::Vector2f(200, 200));
 
 	// Initialise the turret
-	m_turret.setTexture(m_texture);
 	sf::IntRect turretRect(481, 1820, 212, 94);
 	m_turret.setTextureRect(turretRect);
 
@@ -324,29 +324,25 @@ void AITank::updateMovement(double dt)
 	m_turret.setPosition(m_tankBase.getPosition());
 	m_turret.setRotation(m_rotation);
 }
-void AITank::checkProjectileCollision(std::vector<Projectile>& projectiles, GameState const& gameState)
+
+////////////////////////////////////////////////////////////
+void AITank::applyDamage(HitEventQueue const & t_hits)
 {
-	for (auto& projectile : projectiles)
+	int damage = 0;
+	for (HitEvent const & hit : t_hits)
 	{
-		if (projectile.isActive() &&
-			(CollisionDetector::collision(m_tankBase, projectile.getSprite()) ||
-				CollisionDetector::collision(m_turret, projectile.getSprite())))
+		if (hit.m_target == HitTarget::AI_TANK)
 		{
-			
-			applyDamage(projectile.getDamage());  // This should work now
-			projectile.setActive(false);
+			damage += hit.m_damage;
 		}
 	}
-}
-
-
-void AITank::applyDamage(int t_damageAmount)
-{
-	//m_health= m_health + 1;
+	if (damage == 0)
+	{
+		return;
+	}
 
-	m_health -= t_damageAmount;
-	std::cout << m_health;
-	healthText.setString("health : " + std::to_string(m_health));
+	m_health -= damage;
+	Logger::log(LogLevel::INFO, LogCategory::COMBAT, "AI tank hit for {}, health {}", damage, m_health);
 
 	if (m_health < 1 )
 	{
@@ -0,0 +1,63 @@
+#include "Camera.h"
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+Camera::Camera(sf::Vector2f t_size, sf::FloatRect const & t_worldBounds)
+	: m_view(sf::FloatRect(0.0f, 0.0f, t_size.x, t_size.y)),
+	m_worldBounds(t_worldBounds)
+{
+	follow(sf::Vector2f(t_worldBounds.left, t_worldBounds.top));
+}
+
+////////////////////////////////////////////////////////////
+void Camera::setWorldBounds(sf::FloatRect const & t_worldBounds)
+{
+	m_worldBounds = t_worldBounds;
+	follow(m_view.getCenter());
+}
+
+////////////////////////////////////////////////////////////
+void Camera::follow(sf::Vector2f t_target)
+{
+	sf::Vector2f halfSize = m_view.getSize() / 2.0f;
+	sf::Vector2f centre = t_target;
+
+	if (m_worldBounds.width > 2 * halfSize.x)
+	{
+		centre.x = std::clamp(centre.x, m_worldBounds.left + halfSize.x, m_worldBounds.left + m_worldBounds.width - halfSize.x);
+	}
+	else
+	{
+		centre.x = m_worldBounds.left + m_worldBounds.width / 2.0f;
+	}
+
+	if (m_worldBounds.height > 2 * halfSize.y)
+	{
+		centre.y = std::clamp(centre.y, m_worldBounds.top + halfSize.y, m_worldBounds.top + m_worldBounds.height - halfSize.y);
+	}
+	else
+	{
+		centre.y = m_worldBounds.top + m_worldBounds.height / 2.0f;
+	}
+
+	m_view.setCenter(centre);
+	m_visibleArea = sf::FloatRect(centre - halfSize, m_view.getSize());
+}
+
+////////////////////////////////////////////////////////////
+sf::View const & Camera::view() const
+{
+	return m_view;
+}
+
+////////////////////////////////////////////////////////////
+sf::FloatRect const & Camera::visibleArea() const
+{
+	return m_visibleArea;
+}
+
+////////////////////////////////////////////////////////////
+bool Camera::isVisible(sf::FloatRect const & t_bounds) const
+{
+	return m_visibleArea.intersects(t_bounds);
+}
@@ -1,4 +1,31 @@
 #include "CollisionDetector.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <tuple>
+#include <vector>
+
+// Pick the widest SIMD instruction set the compiler targets for collideBatch().
+// Anything else (e.g. ARM builds) uses the scalar loop only.
+#if defined(__AVX__)
+#define COLLISION_BATCH_AVX
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLISION_BATCH_SSE
+#endif
+
+#if defined(COLLISION_BATCH_AVX)
+#include <immintrin.h>
+#elif defined(COLLISION_BATCH_SSE)
+#include <emmintrin.h>
+#endif
 
 bool CollisionDetector::collision(const sf::Sprite& object1, const sf::Sprite& object2) {
 	OrientedBoundingBox OBB1(object1);
@@ -33,44 +60,599 @@ bool CollisionDetector::collision(const sf::Sprite& object1, const sf::Sprite& o
 	return true;	// Collision detected!
 }
 
-using TextureMask = std::vector<sf::Uint8>;
+bool CollisionDetector::collision(const sf::Sprite& object1, const StaticCollider& object2) {
+	OrientedBoundingBox OBB1(object1);
+
+	// The two axes of the moving object change every frame, so both OBBs still have to be projected onto them
+	sf::Vector2f Axes[2] = {
+		sf::Vector2f(OBB1.Points[1].x - OBB1.Points[0].x,
+		OBB1.Points[1].y - OBB1.Points[0].y),
+		sf::Vector2f(OBB1.Points[1].x - OBB1.Points[2].x,
+		OBB1.Points[1].y - OBB1.Points[2].y)
+	};
+
+	for (int i = 0; i<2; i++)
+	{
+		float MinOBB1, MaxOBB1, MinOBB2, MaxOBB2;
+
+		OBB1.ProjectOntoAxis(Axes[i], MinOBB1, MaxOBB1);
+		object2.ProjectOntoAxis(Axes[i], MinOBB2, MaxOBB2);
+
+		if (!((MinOBB2 <= MaxOBB1) && (MaxOBB2 >= MinOBB1)))
+			return false;
+	}
+
+	// ... whereas the static object's own projections onto its axes were computed once, up front
+	for (int i = 0; i<2; i++)
+	{
+		float MinOBB1, MaxOBB1;
+
+		OBB1.ProjectOntoAxis(object2.Axes[i], MinOBB1, MaxOBB1);
+
+		if (!((object2.Min[i] <= MaxOBB1) && (object2.Max[i] >= MinOBB1)))
+			return false;
+	}
+
+	return true;	// Collision detected!
+}
+
+bool CollisionDetector::sweep(const sf::Vector2f& start, const sf::Vector2f& end, float radius, const StaticCollider& object, float& timeOfImpact) {
+	sf::Vector2f path = end - start;
+	float tEnter = 0.0f;
+	float tExit = 1.0f;
+
+	// Slab test: along each of the OBB's axes, find the part of the path that lies between the
+	// outermost projections of the box (grown by the radius). The path hits the box where all of these overlap.
+	for (int i = 0; i<2; i++)
+	{
+		const sf::Vector2f& Axis = object.Axes[i];
+		float grow = radius * std::sqrt(Axis.x*Axis.x + Axis.y*Axis.y); // The axes are not normalised
+		float Min = object.Min[i] - grow;
+		float Max = object.Max[i] + grow;
+
+		float from = start.x*Axis.x + start.y*Axis.y;
+		float along = path.x*Axis.x + path.y*Axis.y;
+
+		if (along == 0.0f)
+		{
+			// Moving parallel to this slab, so either always inside it or never
+			if (from < Min || from > Max)
+				return false;
+			continue;
+		}
+
+		float t1 = (Min - from) / along;
+		float t2 = (Max - from) / along;
+		if (t1 > t2)
+			std::swap(t1, t2);
+
+		tEnter = std::max(tEnter, t1);
+		tExit = std::min(tExit, t2);
+		if (tEnter > tExit)
+			return false;
+	}
+
+	timeOfImpact = tEnter;
+	return true;	// Collision detected!
+}
+
+// Everything about the single OBB that collideBatch() needs, computed once per call
+struct BatchQuery
+{
+	explicit BatchQuery(const OrientedBoundingBox& obb) {
+		// Same axes (and order) as collision() uses for its first object
+		sf::Vector2f Axes[2] = {
+			obb.Points[1] - obb.Points[0],
+			obb.Points[1] - obb.Points[2]
+		};
+		for (int k = 0; k<2; k++)
+		{
+			axisX[k] = Axes[k].x;
+			axisY[k] = Axes[k].y;
+			obb.ProjectOntoAxis(Axes[k], min[k], max[k]);
+		}
+		for (int i = 0; i<4; i++)
+		{
+			x[i] = obb.Points[i].x;
+			y[i] = obb.Points[i].y;
+		}
+	}
+
+	float axisX[2], axisY[2];	// The OBB's own edge axes
+	float min[2], max[2];		// The OBB's projections onto them
+	float x[4], y[4];			// The OBB's corners
+};
+
+// SAT test against a single box of the batch
+static bool collideOne(const BatchQuery& q, const ObbBatch& batch, int b) {
+	// The query's axes: project the box's corners
+	for (int k = 0; k<2; k++)
+	{
+		float lo = batch.X[0][b] * q.axisX[k] + batch.Y[0][b] * q.axisY[k];
+		float hi = lo;
+		for (int i = 1; i<4; i++)
+		{
+			float p = batch.X[i][b] * q.axisX[k] + batch.Y[i][b] * q.axisY[k];
+			lo = std::min(lo, p);
+			hi = std::max(hi, p);
+		}
+		if (!((lo <= q.max[k]) && (hi >= q.min[k])))
+			return false;
+	}
+
+	// The box's axes: project the query's corners, the box's own projections are precomputed
+	for (int k = 0; k<2; k++)
+	{
+		float ax = batch.AxisX[k][b];
+		float ay = batch.AxisY[k][b];
+		float lo = q.x[0] * ax + q.y[0] * ay;
+		float hi = lo;
+		for (int i = 1; i<4; i++)
+		{
+			float p = q.x[i] * ax + q.y[i] * ay;
+			lo = std::min(lo, p);
+			hi = std::max(hi, p);
+		}
+		if (!((batch.Min[k][b] <= hi) && (batch.Max[k][b] >= lo)))
+			return false;
+	}
+	return true;
+}
+
+#if defined(COLLISION_BATCH_SSE)
+// collideOne() for boxes [b, b + 4); bit i of the result is set if box b + i overlaps
+static int collideSse(const BatchQuery& q, const ObbBatch& batch, int b) {
+	__m128 hit = _mm_castsi128_ps(_mm_set1_epi32(-1));
 
-static sf::Uint8 getPixel(const TextureMask& mask, const sf::Texture& tex, uint32_t x, uint32_t y) {
-	if (x > tex.getSize().x || y > tex.getSize().y)
-		return 0;
+	for (int k = 0; k<2; k++)
+	{
+		__m128 ax = _mm_set1_ps(q.axisX[k]);
+		__m128 ay = _mm_set1_ps(q.axisY[k]);
+		__m128 lo = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&batch.X[0][b]), ax), _mm_mul_ps(_mm_loadu_ps(&batch.Y[0][b]), ay));
+		__m128 hi = lo;
+		for (int i = 1; i<4; i++)
+		{
+			__m128 p = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&batch.X[i][b]), ax), _mm_mul_ps(_mm_loadu_ps(&batch.Y[i][b]), ay));
+			lo = _mm_min_ps(lo, p);
+			hi = _mm_max_ps(hi, p);
+		}
+		hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmple_ps(lo, _mm_set1_ps(q.max[k])), _mm_cmpge_ps(hi, _mm_set1_ps(q.min[k]))));
+	}
 
-	return mask[x + y * tex.getSize().x];
+	for (int k = 0; k<2; k++)
+	{
+		__m128 ax = _mm_loadu_ps(&batch.AxisX[k][b]);
+		__m128 ay = _mm_loadu_ps(&batch.AxisY[k][b]);
+		__m128 lo = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(q.x[0]), ax), _mm_mul_ps(_mm_set1_ps(q.y[0]), ay));
+		__m128 hi = lo;
+		for (int i = 1; i<4; i++)
+		{
+			__m128 p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(q.x[i]), ax), _mm_mul_ps(_mm_set1_ps(q.y[i]), ay));
+			lo = _mm_min_ps(lo, p);
+			hi = _mm_max_ps(hi, p);
+		}
+		hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&batch.Min[k][b]), hi), _mm_cmpge_ps(_mm_loadu_ps(&batch.Max[k][b]), lo)));
+	}
+	return _mm_movemask_ps(hit);
 }
+#endif
+
+#if defined(COLLISION_BATCH_AVX)
+// collideOne() for boxes [b, b + 8); bit i of the result is set if box b + i overlaps
+static int collideAvx(const BatchQuery& q, const ObbBatch& batch, int b) {
+	__m256 hit = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+	for (int k = 0; k<2; k++)
+	{
+		__m256 ax = _mm256_set1_ps(q.axisX[k]);
+		__m256 ay = _mm256_set1_ps(q.axisY[k]);
+		__m256 lo = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&batch.X[0][b]), ax), _mm256_mul_ps(_mm256_loadu_ps(&batch.Y[0][b]), ay));
+		__m256 hi = lo;
+		for (int i = 1; i<4; i++)
+		{
+			__m256 p = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&batch.X[i][b]), ax), _mm256_mul_ps(_mm256_loadu_ps(&batch.Y[i][b]), ay));
+			lo = _mm256_min_ps(lo, p);
+			hi = _mm256_max_ps(hi, p);
+		}
+		hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(lo, _mm256_set1_ps(q.max[k]), _CMP_LE_OQ), _mm256_cmp_ps(hi, _mm256_set1_ps(q.min[k]), _CMP_GE_OQ)));
+	}
+
+	for (int k = 0; k<2; k++)
+	{
+		__m256 ax = _mm256_loadu_ps(&batch.AxisX[k][b]);
+		__m256 ay = _mm256_loadu_ps(&batch.AxisY[k][b]);
+		__m256 lo = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(q.x[0]), ax), _mm256_mul_ps(_mm256_set1_ps(q.y[0]), ay));
+		__m256 hi = lo;
+		for (int i = 1; i<4; i++)
+		{
+			__m256 p = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(q.x[i]), ax), _mm256_mul_ps(_mm256_set1_ps(q.y[i]), ay));
+			lo = _mm256_min_ps(lo, p);
+			hi = _mm256_max_ps(hi, p);
+		}
+		hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&batch.Min[k][b]), hi, _CMP_LE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(&batch.Max[k][b]), lo, _CMP_GE_OQ)));
+	}
+	return _mm256_movemask_ps(hit);
+}
+#endif
+
+void CollisionDetector::collideBatch(const OrientedBoundingBox& obb, const ObbBatch& batch, int first, int last, std::uint8_t* outMask) {
+	BatchQuery q(obb);
+	int b = first;
+
+#if defined(COLLISION_BATCH_AVX)
+	for (; b + 8 <= last; b += 8)
+	{
+		int bits = collideAvx(q, batch, b);
+		for (int i = 0; i<8; i++)
+			outMask[b - first + i] = (bits >> i) & 1;
+	}
+#endif
+#if defined(COLLISION_BATCH_SSE)
+	for (; b + 4 <= last; b += 4)
+	{
+		int bits = collideSse(q, batch, b);
+		for (int i = 0; i<4; i++)
+			outMask[b - first + i] = (bits >> i) & 1;
+	}
+#endif
+	// Whatever is left over (or everything, without SIMD)
+	for (; b < last; b++)
+		outMask[b - first] = collideOne(q, batch, b) ? 1 : 0;
+}
+
+void CollisionDetector::collideBatch(const OrientedBoundingBox& obb, const ObbBatch& batch, std::vector<std::uint8_t>& outMask) {
+	outMask.resize(batch.Count());
+	collideBatch(obb, batch, 0, batch.Count(), outMask.data());
+}
+
+// How much of a block of texels is solid.
+enum class Occupancy : std::uint8_t
+{
+	Empty,
+	Full,
+	Mixed
+};
+
+// One level of the occupancy pyramid: the mask split into square blocks of (1 << shift) texels.
+// Blocks on the right and bottom edges may be smaller; they are classed by the texels they do hold.
+struct BlockLevel
+{
+	int shift = 0;
+	int columns = 0;
+	int rows = 0;
+	std::vector<Occupancy> blocks;
+
+	Occupancy at(int bx, int by) const {
+		return blocks[by * columns + bx];
+	}
+
+	// Classes the texel rect [x0, x1] x [y0, y1] (inclusive) by the blocks covering it.
+	// Full and Empty are exact for the covered blocks, so they are also true for the rect.
+	Occupancy classify(int x0, int y0, int x1, int y1) const {
+		bool anyFull = false;
+		bool anyEmpty = false;
+		for (int by = y0 >> shift; by <= y1 >> shift; ++by)
+		{
+			for (int bx = x0 >> shift; bx <= x1 >> shift; ++bx)
+			{
+				Occupancy block = at(bx, by);
+				anyFull |= block == Occupancy::Full;
+				anyEmpty |= block == Occupancy::Empty;
+				if (block == Occupancy::Mixed || (anyFull && anyEmpty))
+					return Occupancy::Mixed;
+			}
+		}
+		return anyFull ? Occupancy::Full : Occupancy::Empty;
+	}
+};
+
+// A collision mask for one texture sub-rect, one bit per texel, packed into 64 bit words per row.
+// A bit is set where the texel's alpha is above the threshold the mask was baked with.
+// On top of the bits sits a two level occupancy pyramid of 8x8 and 4x4 blocks, so
+//  pixelPerfectTest() can accept or reject whole regions without visiting their texels.
+struct CollisionMask
+{
+	int width = 0;
+	int height = 0;
+	int wordsPerRow = 0;
+	std::vector<std::uint64_t> bits;
+	BlockLevel blocks8;
+	BlockLevel blocks4;
+
+	bool test(int x, int y) const {
+		return (bits[y * wordsPerRow + (x >> 6)] >> (x & 63)) & 1u;
+	}
+
+	// Builds the pyramid from the bits. Call once the bits are final.
+	void buildPyramid() {
+		blocks4.shift = 2;
+		blocks4.columns = (width + 3) / 4;
+		blocks4.rows = (height + 3) / 4;
+		blocks4.blocks.resize(blocks4.columns * blocks4.rows);
+
+		// A 4 texel wide block never straddles two 64 bit words
+		for (int by = 0; by < blocks4.rows; ++by)
+		{
+			int y1 = std::min(by * 4 + 4, height);
+			for (int bx = 0; bx < blocks4.columns; ++bx)
+			{
+				int x0 = bx * 4;
+				int bitCount = std::min(4, width - x0);
+				std::uint64_t valid = (std::uint64_t(1) << bitCount) - 1;
+				bool full = true;
+				bool empty = true;
+				for (int y = by * 4; y < y1; ++y)
+				{
+					std::uint64_t texels = (bits[y * wordsPerRow + (x0 >> 6)] >> (x0 & 63)) & valid;
+					full &= texels == valid;
+					empty &= texels == 0;
+				}
+				blocks4.blocks[by * blocks4.columns + bx] = full ? Occupancy::Full : empty ? Occupancy::Empty : Occupancy::Mixed;
+			}
+		}
+
+		// Each 8x8 block is classed from the (up to) four 4x4 blocks it holds
+		blocks8.shift = 3;
+		blocks8.columns = (width + 7) / 8;
+		blocks8.rows = (height + 7) / 8;
+		blocks8.blocks.resize(blocks8.columns * blocks8.rows);
+		for (int by = 0; by < blocks8.rows; ++by)
+		{
+			for (int bx = 0; bx < blocks8.columns; ++bx)
+			{
+				blocks8.blocks[by * blocks8.columns + bx] = blocks4.classify(bx * 8, by * 8,
+					std::min(bx * 8 + 7, width - 1), std::min(by * 8 + 7, height - 1));
+			}
+		}
+	}
+
+	// Classes the texel space rect [minX, maxX] x [minY, maxY] by what a sample falling inside it would hit.
+	// As in sampleRow(), samples outside (or on the edge of) the mask never hit anything.
+	Occupancy classify(float minX, float minY, float maxX, float maxY) const {
+		if (maxX <= 0 || maxY <= 0 || minX >= width || minY >= height)
+			return Occupancy::Empty;
+
+		int x0 = std::max(0, static_cast<int>(minX));
+		int y0 = std::max(0, static_cast<int>(minY));
+		int x1 = std::min(width - 1, static_cast<int>(maxX));
+		int y1 = std::min(height - 1, static_cast<int>(maxY));
+
+		// Coarse to fine: only refine when the 8x8 blocks disagree
+		Occupancy occupancy = blocks8.classify(x0, y0, x1, y1);
+		if (occupancy == Occupancy::Mixed)
+			occupancy = blocks4.classify(x0, y0, x1, y1);
+
+		// A rect hanging over the edge of the mask is only full for the samples that land inside it
+		bool inside = minX > 0 && minY > 0 && maxX < width && maxY < height;
+		if (occupancy == Occupancy::Full && !inside)
+			return Occupancy::Mixed;
+		return occupancy;
+	}
+};
+
+// Masks are baked per texture, sub-rect and alpha threshold.
+struct MaskKey
+{
+	const sf::Texture* texture;
+	int left, top, width, height;
+	sf::Uint8 alphaLimit;
+
+	bool operator<(const MaskKey& other) const {
+		return std::tie(texture, left, top, width, height, alphaLimit) <
+			std::tie(other.texture, other.left, other.top, other.width, other.height, other.alphaLimit);
+	}
+};
+
+// A mask covering a whole texture, baked from its source image at load time.
+// The bits either live in the storage vector or, when loaded from the cache file, in the mapped file.
+struct SheetMask
+{
+	int width = 0;
+	int height = 0;
+	int wordsPerRow = 0;
+	sf::Uint8 alphaLimit = 0;
+	const std::uint64_t* bits = nullptr;
+	std::vector<std::uint64_t> storage;
+	MappedFile file;
+
+	bool test(int x, int y) const {
+		return (bits[y * wordsPerRow + (x >> 6)] >> (x & 63)) & 1u;
+	}
+};
+
+// Layout of the mask cache file: this header, followed by height rows of wordsPerRow 64 bit words.
+// The source size and write time identify the image the mask was baked from;
+//  a cache whose header does not match the current image is rebaked.
+struct MaskCacheHeader
+{
+	std::uint32_t magic;
+	std::uint32_t version;
+	std::uint32_t width;
+	std::uint32_t height;
+	std::uint32_t alphaLimit;
+	std::uint32_t wordsPerRow;
+	std::uint64_t sourceSize;
+	std::int64_t sourceTime;
+};
+
+static const std::uint32_t s_MASK_CACHE_MAGIC = 0x4B53414D; // "MASK"
+// Bump whenever the layout or the baking rule changes.
+static const std::uint32_t s_MASK_CACHE_VERSION = 1;
 
 class BitmaskRegistry
 {
 public:
-	auto& create(const sf::Texture& tex, const sf::Image& img) {
-		auto mask = TextureMask(tex.getSize().y * tex.getSize().x);
+	const CollisionMask& create(const MaskKey& key, const sf::Image& img) {
+		CollisionMask mask;
+		mask.width = key.width;
+		mask.height = key.height;
+		mask.wordsPerRow = (key.width + 63) / 64;
+		mask.bits.assign(mask.wordsPerRow * key.height, 0);
+
+		// Only read texels that are actually inside the image
+		int right = std::min<int>(key.left + key.width, img.getSize().x);
+		int bottom = std::min<int>(key.top + key.height, img.getSize().y);
 
-		for (uint32_t y = 0; y < tex.getSize().y; ++y)
+		for (int y = std::max(key.top, 0); y < bottom; ++y)
 		{
-			for (uint32_t x = 0; x < tex.getSize().x; ++x)
-				mask[x + y * tex.getSize().x] = img.getPixel(x, y).a;
+			for (int x = std::max(key.left, 0); x < right; ++x)
+			{
+				if (img.getPixel(x, y).a > key.alphaLimit)
+				{
+					int maskX = x - key.left;
+					mask.bits[(y - key.top) * mask.wordsPerRow + (maskX >> 6)] |= std::uint64_t(1) << (maskX & 63);
+				}
+			}
 		}
 
+		mask.buildPyramid();
+
 		// store and return ref to the mask
-		return (bitmasks[&tex] = std::move(mask));
+		return (bitmasks[key] = std::move(mask));
+	}
+
+	// Cuts a sub-rect mask out of a baked sheet mask. No texture readback is needed.
+	const CollisionMask& create(const MaskKey& key, const SheetMask& sheet) {
+		CollisionMask mask;
+		mask.width = key.width;
+		mask.height = key.height;
+		mask.wordsPerRow = (key.width + 63) / 64;
+		mask.bits.assign(mask.wordsPerRow * key.height, 0);
+
+		int right = std::min(key.left + key.width, sheet.width);
+		int bottom = std::min(key.top + key.height, sheet.height);
+
+		for (int y = std::max(key.top, 0); y < bottom; ++y)
+		{
+			for (int x = std::max(key.left, 0); x < right; ++x)
+			{
+				if (sheet.test(x, y))
+				{
+					int maskX = x - key.left;
+					mask.bits[(y - key.top) * mask.wordsPerRow + (maskX >> 6)] |= std::uint64_t(1) << (maskX & 63);
+				}
+			}
+		}
+		mask.buildPyramid();
+
+		return (bitmasks[key] = std::move(mask));
 	}
 
-	auto& get(const sf::Texture& tex) {
-		auto pair = bitmasks.find(&tex);
+	// A null texture is the one registered for sprites without a texture.
+	const CollisionMask& get(const sf::Texture* tex, const sf::IntRect& rect, sf::Uint8 alphaLimit) {
+		MaskKey key{ tex, rect.left, rect.top, rect.width, rect.height, alphaLimit };
+		auto pair = bitmasks.find(key);
 		if (pair == bitmasks.end())
 		{
-			return create(tex, tex.copyToImage());
+			auto sheet = sheets.find(tex);
+			if (sheet != sheets.end() && sheet->second.alphaLimit == alphaLimit)
+			{
+				return create(key, sheet->second);
+			}
+
+			// The texture was not registered with loadMasks() (or with another threshold),
+			//  so fall back to a synchronous GPU readback. Without a texture nothing is solid.
+			return create(key, tex != nullptr ? tex->copyToImage() : sf::Image());
 		}
 
 		return pair->second;
 	}
 
-	
+	// Bakes or loads the sheet mask of a texture, replacing any previous one.
+	void load(const sf::Texture* tex, const sf::Image& img, const std::string& sourceFile, sf::Uint8 alphaLimit) {
+		// Sub-rect masks cut from an older sheet are stale now
+		for (auto it = bitmasks.begin(); it != bitmasks.end();)
+		{
+			it = (it->first.texture == tex) ? bitmasks.erase(it) : std::next(it);
+		}
+		sheets.erase(tex);
+		SheetMask& sheet = sheets[tex];
+
+		sheet.width = static_cast<int>(img.getSize().x);
+		sheet.height = static_cast<int>(img.getSize().y);
+		sheet.wordsPerRow = (sheet.width + 63) / 64;
+		sheet.alphaLimit = alphaLimit;
+
+		MaskCacheHeader expected{};
+		expected.magic = s_MASK_CACHE_MAGIC;
+		expected.version = s_MASK_CACHE_VERSION;
+		expected.width = sheet.width;
+		expected.height = sheet.height;
+		expected.alphaLimit = alphaLimit;
+		expected.wordsPerRow = sheet.wordsPerRow;
+
+		std::string cacheFile;
+		std::error_code error;
+		if (!sourceFile.empty())
+		{
+			expected.sourceSize = std::filesystem::file_size(sourceFile, error);
+			if (!error)
+			{
+				expected.sourceTime = std::filesystem::last_write_time(sourceFile, error).time_since_epoch().count();
+			}
+			if (!error)
+			{
+				cacheFile = sourceFile + ".mask";
+			}
+		}
+
+		std::size_t words = static_cast<std::size_t>(sheet.wordsPerRow) * sheet.height;
+		if (!cacheFile.empty() && sheet.file.open(cacheFile))
+		{
+			MaskCacheHeader header;
+			if (sheet.file.size() == sizeof(header) + words * sizeof(std::uint64_t))
+			{
+				std::memcpy(&header, sheet.file.data(), sizeof(header));
+				if (std::memcmp(&header, &expected, sizeof(header)) == 0)
+				{
+					// The mapping is page aligned and the header is a multiple of 8 bytes, so the words are aligned
+					sheet.bits = reinterpret_cast<const std::uint64_t*>(sheet.file.data() + sizeof(header));
+					return;
+				}
+			}
+			sheet.file.close();
+		}
+
+		// Bake straight from the pixel array, row by row
+		sheet.storage.assign(words, 0);
+		const sf::Uint8* pixels = img.getPixelsPtr();
+		for (int y = 0; y < sheet.height; ++y)
+		{
+			std::uint64_t* row = sheet.storage.data() + static_cast<std::size_t>(y) * sheet.wordsPerRow;
+			const sf::Uint8* alpha = pixels + static_cast<std::size_t>(y) * sheet.width * 4 + 3;
+			for (int x = 0; x < sheet.width; ++x, alpha += 4)
+			{
+				if (*alpha > alphaLimit)
+				{
+					row[x >> 6] |= std::uint64_t(1) << (x & 63);
+				}
+			}
+		}
+		sheet.bits = sheet.storage.data();
+
+		if (!cacheFile.empty())
+		{
+			// Write to a temporary file and rename it, so a crash never leaves a half written cache behind
+			std::string tempFile = cacheFile + ".tmp";
+			std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+			out.write(reinterpret_cast<const char*>(&expected), sizeof(expected));
+			out.write(reinterpret_cast<const char*>(sheet.storage.data()), words * sizeof(std::uint64_t));
+			out.close();
+			if (out)
+			{
+				std::filesystem::rename(tempFile, cacheFile, error);
+			}
+			if (!out || error)
+			{
+				std::cout << "Could not write collision mask cache " << cacheFile << std::endl;
+				std::filesystem::remove(tempFile, error);
+			}
+		}
+	}
+
 private:
-	std::map<const sf::Texture*, TextureMask> bitmasks;
+	std::map<MaskKey, CollisionMask> bitmasks;
+	std::map<const sf::Texture*, SheetMask> sheets;
 };
 
 // Gets global instance of BitmaskRegistry.
@@ -80,35 +662,170 @@ static BitmaskRegistry& bitmasks() {
 	return instance;
 }
 
+// The affine mapping from world space into a sprite's texel space.
+// The inverse transform is fetched once per test; along a row the texel coordinates
+// are then advanced by adding stepX, rather than by a matrix multiply per pixel.
+struct TexelMapping
+{
+	TexelMapping(const sf::Sprite& sprite, const CollisionMask& mask) : mask(mask) {
+		// sf::Transform is a column major 4x4 matrix
+		const float* m = sprite.getInverseTransform().getMatrix();
+		stepX = sf::Vector2f(m[0], m[1]);
+		stepY = sf::Vector2f(m[4], m[5]);
+		offset = sf::Vector2f(m[12], m[13]);
+	}
+
+	// Texel coordinates of world point (x, y)
+	sf::Vector2f rowStart(float x, float y) const {
+		return offset + stepX * x + stepY * y;
+	}
+
+	// Narrows [first, last) to the pixels of a row whose texel coordinates can land inside the mask.
+	// The range is conservative by a pixel at each end; sampleRow() does the exact test.
+	void clip(sf::Vector2f start, int& first, int& last) const {
+		clipAxis(start.x, stepX.x, mask.width, first, last);
+		clipAxis(start.y, stepX.y, mask.height, first, last);
+	}
+
+	// Classes the block of pixels [k0, k1) x [j0, j1) of the rect whose top left pixel is at world (x, y).
+	// The texel footprint of the samples is padded slightly, to stay conservative with respect to
+	//  the rounding of the incremental stepping in sampleRow().
+	Occupancy classify(float x, float y, int k0, int j0, int k1, int j1) const {
+		sf::Vector2f corner = rowStart(x + k0, y + j0);
+		sf::Vector2f across = stepX * static_cast<float>(k1 - 1 - k0);
+		sf::Vector2f down = stepY * static_cast<float>(j1 - 1 - j0);
+		const float pad = 1.0f / 64;
+
+		float minX = corner.x + std::min(across.x, 0.0f) + std::min(down.x, 0.0f) - pad;
+		float maxX = corner.x + std::max(across.x, 0.0f) + std::max(down.x, 0.0f) + pad;
+		float minY = corner.y + std::min(across.y, 0.0f) + std::min(down.y, 0.0f) - pad;
+		float maxY = corner.y + std::max(across.y, 0.0f) + std::max(down.y, 0.0f) + pad;
+		return mask.classify(minX, minY, maxX, maxY);
+	}
+
+	const CollisionMask& mask;
+	sf::Vector2f stepX;
+	sf::Vector2f stepY;
+	sf::Vector2f offset;
+
+private:
+	// Solves 0 < start + k * step < size for k
+	static void clipAxis(float start, float step, int size, int& first, int& last) {
+		if (first >= last)
+			return;
+		if (step == 0.0f)
+		{
+			if (!(start > 0 && start < size))
+				last = first;
+			return;
+		}
+
+		double lo = -start / static_cast<double>(step);
+		double hi = (size - start) / static_cast<double>(step);
+		if (lo > hi)
+			std::swap(lo, hi);
+
+		first = std::max(first, static_cast<int>(std::clamp(std::floor(lo), static_cast<double>(first), static_cast<double>(last))));
+		last = std::min(last, static_cast<int>(std::clamp(std::ceil(hi) + 1.0, static_cast<double>(first), static_cast<double>(last))));
+	}
+};
+
+// Samples pixels [first, last) of one row of the intersection rectangle against a sprite's mask.
+// Bit k of the result is set if world point (x + k, y) lands on a solid texel of the sprite,
+//  where start holds the texel coordinates of (x, y).
+// Returns false if no bit was set.
+static bool sampleRow(const TexelMapping& mapping, sf::Vector2f start, int first, int last, std::vector<std::uint64_t>& row) {
+	const CollisionMask& mask = mapping.mask;
+	sf::Vector2f v = start + mapping.stepX * static_cast<float>(first);
+	bool any = false;
+
+	std::fill(row.begin(), row.end(), 0);
+	for (int k = first; k < last; ++k, v += mapping.stepX)
+	{
+		// Make sure pixels fall within the sprite's subrect
+		if (v.x > 0 && v.y > 0 && v.x < mask.width && v.y < mask.height &&
+			mask.test(static_cast<int>(v.x), static_cast<int>(v.y)))
+		{
+			row[k >> 6] |= std::uint64_t(1) << (k & 63);
+			any = true;
+		}
+	}
+	return any;
+}
+
 
+void CollisionDetector::loadMasks(const sf::Texture& texture, const sf::Image& image, const std::string& sourceFile, sf::Uint8 alphaLimit) {
+	bitmasks().load(&texture, image, sourceFile, alphaLimit);
+}
+
+void CollisionDetector::loadMasks(const sf::Texture* texture, const sf::Image& image, const std::string& sourceFile, sf::Uint8 alphaLimit) {
+	bitmasks().load(texture, image, sourceFile, alphaLimit);
+}
 
 bool CollisionDetector::pixelPerfectTest(const sf::Sprite& sprite1, const sf::Sprite& sprite2, sf::Uint8 alphaLimit) {
 	sf::FloatRect intersection;
 	if (!sprite1.getGlobalBounds().intersects(sprite2.getGlobalBounds(), intersection))
 		return false;
 
-	auto s1SubRect = sprite1.getTextureRect();
-	auto s2SubRect = sprite2.getTextureRect();
+	TexelMapping mapping1(sprite1, bitmasks().get(sprite1.getTexture(), sprite1.getTextureRect(), alphaLimit));
+	TexelMapping mapping2(sprite2, bitmasks().get(sprite2.getTexture(), sprite2.getTextureRect(), alphaLimit));
 
-	auto& mask1 = bitmasks().get(*sprite1.getTexture());
-	auto& mask2 = bitmasks().get(*sprite2.getTexture());
+	int columns = static_cast<int>(std::ceil(intersection.width));
+	int rows = static_cast<int>(std::ceil(intersection.height));
 
-	// Loop through our pixels
-	for (auto i = intersection.left; i < intersection.left + intersection.width; ++i) {
-		for (auto j = intersection.top; j < intersection.top + intersection.height; ++j) {
+	// Scratch rows, reused between calls
+	static thread_local std::vector<std::uint64_t> row1, row2;
+	row1.resize((columns + 63) / 64);
+	row2.resize(row1.size());
 
-			auto s1v = sprite1.getInverseTransform().transformPoint(i, j);
-			auto s2v = sprite2.getInverseTransform().transformPoint(i, j);
+	// Work through the intersection in square tiles of pixels, a band of tiles at a time.
+	// A tile that is empty in either sprite is skipped, a tile that is full in both is a hit,
+	//  and only the span of mixed tiles in a band is tested pixel by pixel.
+	const int tileSize = 8;
+	for (int j0 = 0; j0 < rows; j0 += tileSize) {
+		int j1 = std::min(j0 + tileSize, rows);
 
-			// Make sure pixels fall within the sprite's subrect
-			if (s1v.x > 0 && s1v.y > 0 && s2v.x > 0 && s2v.y > 0 &&
-				s1v.x < s1SubRect.width && s1v.y < s1SubRect.height &&
-				s2v.x < s2SubRect.width && s2v.y < s2SubRect.height) {
+		int spanFirst = columns;
+		int spanLast = 0;
+		for (int k0 = 0; k0 < columns; k0 += tileSize) {
+			int k1 = std::min(k0 + tileSize, columns);
+			Occupancy occupancy1 = mapping1.classify(intersection.left, intersection.top, k0, j0, k1, j1);
+			if (occupancy1 == Occupancy::Empty)
+				continue;
+			Occupancy occupancy2 = mapping2.classify(intersection.left, intersection.top, k0, j0, k1, j1);
+			if (occupancy2 == Occupancy::Empty)
+				continue;
+			if (occupancy1 == Occupancy::Full && occupancy2 == Occupancy::Full)
+				return true;
 
-				if (getPixel(mask1, *sprite1.getTexture(), (int)(s1v.x) + s1SubRect.left, (int)(s1v.y) + s1SubRect.top) > alphaLimit &&
-					getPixel(mask2, *sprite2.getTexture(), (int)(s2v.x) + s2SubRect.left, (int)(s2v.y) + s2SubRect.top) > alphaLimit)
-					return true;
+			spanFirst = std::min(spanFirst, k0);
+			spanLast = k1;
+		}
+		if (spanFirst >= spanLast)
+			continue;
+
+		// Build a bit row per sprite and then AND them a word at a time
+		for (int j = j0; j < j1; ++j) {
+			float y = intersection.top + j;
+			sf::Vector2f start1 = mapping1.rowStart(intersection.left, y);
+			sf::Vector2f start2 = mapping2.rowStart(intersection.left, y);
 
+			// Only the part of the row that lies inside both sub-rects can collide
+			int first = spanFirst;
+			int last = spanLast;
+			mapping1.clip(start1, first, last);
+			mapping2.clip(start2, first, last);
+			if (first >= last)
+				continue;
+
+			if (!sampleRow(mapping1, start1, first, last, row1))
+				continue;
+			if (!sampleRow(mapping2, start2, first, last, row2))
+				continue;
+
+			for (int w = first >> 6; w <= (last - 1) >> 6; ++w) {
+				if (row1[w] & row2[w])
+					return true;
 			}
 		}
 	}
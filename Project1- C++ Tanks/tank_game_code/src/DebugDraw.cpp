@@ -0,0 +1,57 @@
+#include "DebugDraw.h"
+
+#ifdef DEBUG_DRAW
+#include <cmath>
+#include <numbers>
+
+bool DebugDraw::s_enabled{ true };
+sf::VertexArray DebugDraw::s_lines{ sf::Lines };
+
+////////////////////////////////////////////////////////////
+void DebugDraw::line(sf::Vector2f t_from, sf::Vector2f t_to, sf::Color t_colour)
+{
+	if (!s_enabled)
+	{
+		return;
+	}
+	s_lines.append(sf::Vertex(t_from, t_colour));
+	s_lines.append(sf::Vertex(t_to, t_colour));
+}
+
+////////////////////////////////////////////////////////////
+void DebugDraw::circle(sf::Vector2f t_centre, float t_radius, sf::Color t_colour)
+{
+	if (!s_enabled)
+	{
+		return;
+	}
+
+	float const step = static_cast<float>(2.0 * std::numbers::pi / s_CIRCLE_SEGMENTS);
+	sf::Vector2f previous = t_centre + sf::Vector2f(t_radius, 0.0f);
+	for (int i = 1; i <= s_CIRCLE_SEGMENTS; ++i)
+	{
+		sf::Vector2f next = t_centre + sf::Vector2f(std::cos(step * i), std::sin(step * i)) * t_radius;
+		s_lines.append(sf::Vertex(previous, t_colour));
+		s_lines.append(sf::Vertex(next, t_colour));
+		previous = next;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void DebugDraw::render(sf::RenderTarget & t_target)
+{
+	if (s_lines.getVertexCount() > 0)
+	{
+		t_target.draw(s_lines);
+		// Keeps its storage, so recording does not allocate after the first few frames.
+		s_lines.clear();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void DebugDraw::setEnabled(bool t_enabled)
+{
+	s_enabled = t_enabled;
+	s_lines.clear();
+}
+#endif // DEBUG_DRAW
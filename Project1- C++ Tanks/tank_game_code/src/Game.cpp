@@ -1,26 +1,22 @@
 #include "Game.h"
 #include <iostream>
-
-// Our target FPS
-static double const FPS{ 60.0f };
+#include <algorithm>
 
 ////////////////////////////////////////////////////////////
-Game::Game()
+Game::Game(double t_tickRate)
 	: m_window(sf::VideoMode(ScreenSize::s_width, ScreenSize::s_height, 32),
 		"SFML Playground", sf::Style::Default), 
-		m_tank(m_holder, m_wallSprites),
-		m_aiTank(m_holder["tankAtlas"], m_wallSprites),
-		m_hud(m_font)
+		m_world(World::loadAtlas(&m_holder)),
+		m_hud(m_font, m_arialFont),
+		m_camera(sf::Vector2f(ScreenSize::s_width, ScreenSize::s_height),
+			sf::FloatRect(0.0f, 0.0f, ScreenSize::s_width, ScreenSize::s_height)),
+		m_batch(m_window),
+		m_profilerOverlay(m_arialFont),
+		m_tickSeconds(1.0 / t_tickRate)
 {
 	
 	init();
 
-	using std::placeholders::_1;
-	m_funcApplyDamage = std::bind(&AITank::applyDamage, &m_aiTank, _1);
-	
-	std::cout << "AI Tank Position: " << m_level.m_aiTank.m_position.x
-		<< ", " << m_level.m_aiTank.m_position.y << std::endl;
-
 	if (!m_font.loadFromFile("./resources/fonts/akashi.ttf"))
 	{
 		std::string s("error loading font");
@@ -37,19 +33,6 @@ void Game::init()
 	
 
 	sf::Texture& texture = m_holder["tankAtlas"];
-	int currentLevel = 1;
-
-	// Will generate an exception if level loading fails
-	try 
-	{ 
-		LevelLoader::load(currentLevel, m_level); 
-	}
-	catch (std::exception& e) 
-	{ 
-		std::cout << "Level Loading failure." << std::endl;
-		std::cout << e.what() << std::endl;
-		throw e;
-	}
 	// Really only necessary is our target FPS is greater than 60.
 	m_window.setVerticalSyncEnabled(true);
 
@@ -57,11 +40,21 @@ void Game::init()
 	{
 		std::cout << "Error loading font file";
 	}
-	generateWalls();
+	m_wallLayer.build(m_world.walls());
+	sf::IntRect backgroundRect(0, 0, 2000, 1500);
+	for (int top = 0; top < backgroundRect.height; top += s_BACKGROUND_TILE_SIZE)
+	{
+		for (int left = 0; left < backgroundRect.width; left += s_BACKGROUND_TILE_SIZE)
+		{
+			sf::Sprite tile(texture, sf::IntRect(backgroundRect.left + left, backgroundRect.top + top,
+				std::min(s_BACKGROUND_TILE_SIZE, backgroundRect.width - left),
+				std::min(s_BACKGROUND_TILE_SIZE, backgroundRect.height - top)));
+			tile.setPosition(static_cast<float>(left), static_cast<float>(top));
+			m_bgTiles.push_back(tile);
+		}
+	}
 
-	m_aiTank.init(m_level.m_aiTank.m_position, m_level.m_aiTank.m_scale);
-	m_bgSprite.setTexture(texture);
-	m_bgSprite.setTextureRect(sf::IntRect(0, 0, 2000, 1500));
+	m_camera.setWorldBounds(m_world.bounds());
 	
 #ifdef TEST_FPS
 	x_updateFPS.setFont(m_arialFont);
@@ -78,41 +71,123 @@ void Game::init()
 ////////////////////////////////////////////////////////////
 void Game::run()
 {
-	sf::Clock clock;
-	sf::Time timeSinceLastUpdate = sf::Time::Zero;
-	
-	sf::Time timePerFrame = sf::seconds(1.0f / FPS); // 60 fps
+	if (!m_recordFile.empty())
+	{
+		m_recording.begin(1.0 / m_tickSeconds, m_world.stateHash());
+	}
+	if (m_replaying && m_recording.initialHash() != m_world.stateHash())
+	{
+		Logger::log(LogLevel::WARNING, LogCategory::GENERAL, "Replay starts from a different world than was recorded");
+	}
+
+	// The window is drawn to from this thread only.
+	Profiler::setThreadName("render");
+	publishSnapshot();
+	m_running = true;
+	m_simulation = std::thread(&Game::simulate, this);
+
 	while (m_window.isOpen())
 	{
 		processEvents(); // as many as possible
-		timeSinceLastUpdate += clock.restart();
-		while (timeSinceLastUpdate > timePerFrame)
-		{
-			timeSinceLastUpdate -= timePerFrame;
-			processEvents(); // at least 60 fps
-			update(timePerFrame.asMilliseconds()); //60 fps
+		m_keyboardControls.store(TankInput::fromKeyboard().m_controls);
+		render(); // as many as possible
+		// Outside render(), so its profile shows the drawing and not the wait for vsync
+		m_window.display();
 #ifdef TEST_FPS
-			x_secondTime += timePerFrame;
-			x_updateFrameCount++;
-			if (x_secondTime.asSeconds() > 1)
-			{
-				std::string updatesPS = "UPS " + std::to_string(x_updateFrameCount - 1);
-				x_updateFPS.setString(updatesPS);
-				std::string drawsPS = "DPS " + std::to_string(x_drawFrameCount);
-				x_drawFPS.setString(drawsPS);
-				x_updateFrameCount = 0;
-				x_drawFrameCount = 0;
-				x_secondTime = sf::Time::Zero;
-			}
+		x_drawFrameCount++;
+		if (x_secondClock.getElapsedTime().asSeconds() > 1)
+		{
+			std::string updatesPS = "UPS " + std::to_string(x_updateFrameCount.exchange(0));
+			x_updateFPS.setString(updatesPS);
+			std::string drawsPS = "DPS " + std::to_string(x_drawFrameCount);
+			x_drawFPS.setString(drawsPS);
+			x_drawFrameCount = 0;
+			x_secondClock.restart();
+		}
 #endif
+	}
+
+	m_running = false;
+	m_simulation.join();
+
+	if (!m_recordFile.empty())
+	{
+		try
+		{
+			m_recording.save(m_recordFile);
+			std::cout << "Recorded " << m_recording.tickCount() << " ticks to " << m_recordFile << std::endl;
 		}
-		render(); // as many as possible
+		catch (std::exception& e)
+		{
+			std::cout << e.what() << std::endl;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void Game::recordTo(std::string const & t_fileName)
+{
+	m_recordFile = t_fileName;
+	m_replaying = false;
+}
+
+////////////////////////////////////////////////////////////
+void Game::replay(InputRecording const & t_recording)
+{
+	m_recording = t_recording;
+	m_recordFile.clear();
+	m_replaying = true;
+}
+
+////////////////////////////////////////////////////////////
+void Game::simulate()
+{
+	Profiler::setThreadName("simulation");
+	sf::Clock clock;
+	double accumulator = 0.0;
+
+	while (m_running)
+	{
+		accumulator += clock.restart().asMicroseconds() / 1000000.0;
+		// Never clamp below one tick, or a slow tick rate would never update at all
+		accumulator = std::min(accumulator, std::max(s_MAX_FRAME_SECONDS, m_tickSeconds));
+		while (accumulator >= m_tickSeconds)
+		{
+			accumulator -= m_tickSeconds;
+			bool replayed = m_replaying && m_tick < m_recording.tickCount();
+			TankInput input;
+			input.m_controls = replayed ? m_recording.input(m_tick).m_controls : m_keyboardControls.load();
+			m_world.update(m_tickSeconds * 1000.0, input);
+			if (replayed && !m_diverged && !m_recording.matches(m_tick, m_world.stateHash()))
+			{
+				m_diverged = true;
+				Logger::log(LogLevel::WARNING, LogCategory::GENERAL, "Replay diverged from the recording at tick {}", m_tick);
+			}
+			else if (!m_recordFile.empty())
+			{
+				m_recording.add(input, m_world.stateHash());
+			}
+			m_tick++;
+			publishSnapshot();
 #ifdef TEST_FPS
-		x_drawFrameCount++;
+			x_updateFrameCount++;
 #endif
+		}
+
+		// Sleep until the next tick is due
+		std::this_thread::sleep_for(std::chrono::duration<double>(m_tickSeconds - accumulator));
 	}
 }
 
+////////////////////////////////////////////////////////////
+void Game::publishSnapshot()
+{
+	RenderSnapshot & snapshot = m_snapshots.back();
+	m_world.snapshot(snapshot);
+	snapshot.m_publishTime = std::chrono::steady_clock::now();
+	m_snapshots.publish();
+}
+
 ////////////////////////////////////////////////////////////
 void Game::processEvents()
 {
@@ -138,8 +213,11 @@ void Game::processGameEvents(sf::Event& event)
 		case sf::Keyboard::Escape:
 			m_window.close();
 			break;
-		case sf::Keyboard::C:
-			shouldTankRotate = true;
+		case sf::Keyboard::F1:
+			DebugDraw::setEnabled(!DebugDraw::isEnabled());
+			break;
+		case sf::Keyboard::F2:
+			m_profilerOverlay.setVisible(!m_profilerOverlay.isVisible());
 			break;
 		default:
 			break;
@@ -147,95 +225,45 @@ void Game::processGameEvents(sf::Event& event)
 	}
 }
 
-void Game::generateWalls()
-{
-	sf::Texture& texture = m_holder["tankAtlas"]; 
-	// Replace the ? With the actual values for the wall image
-	sf::IntRect wallRect(0,1501,30, 30);
-	// Create the Walls
-	for (auto const& obstacle : m_level.m_obstacles)
-	{
-		sf::Sprite sprite;
-		sprite.setTexture(texture);
-		sprite.setTextureRect(wallRect);
-		sprite.setOrigin(
-			wallRect.width / 2.0, wallRect.height / 2.0);
-		sprite.setPosition(obstacle.m_position);
-		sprite.setRotation(obstacle.m_rotation);
-		m_wallSprites.push_back(sprite);
-	}
-}
-void Game::setGameState(GameState newState)
+////////////////////////////////////////////////////////////
+void Game::render()
 {
-	m_currentGameState = newState;
+	PROFILE_SCOPE(ProfileZone::RENDER);
+	RenderSnapshot const & snapshot = m_snapshots.acquire();
+	double sinceTick = std::chrono::duration<double>(std::chrono::steady_clock::now() - snapshot.m_publishTime).count();
+	float alpha = static_cast<float>(std::clamp(sinceTick / m_tickSeconds, 0.0, 1.0));
 
-}
+	m_window.clear(sf::Color(0, 0, 0, 0));
 
-////////////////////////////////////////////////////////////
-void Game::update(double dt)
-{
-	if (m_aiTank.health() == 0)
-	{
-		// Collision detected, set game state to GAME_WIN
-		setGameState(GameState::GAME_WIN);
+	m_camera.follow(snapshot.m_player.position(alpha));
 
-	}
-	m_hud.update(m_currentGameState);
-	switch (m_currentGameState)
+	m_window.setView(m_camera.view());
+	for (sf::Sprite const& tile : m_bgTiles)
 	{
-	case GameState::GAME_RUNNING:
-		m_tank.update(dt, m_aiTank.getBase(), m_funcApplyDamage);
-		if (shouldTankRotate)
-		{
-			shouldTankRotate = m_tank.centreTurret();
-		}
-		m_aiTank.update(m_tank, dt);
-
-		if (m_tank.getBase().getGlobalBounds().intersects(m_aiTank.getBase().getGlobalBounds()))
+		if (m_camera.isVisible(tile.getGlobalBounds()))
 		{
-			// Collision detected, set game state to GAME_LOSE
-			setGameState(GameState::GAME_LOSE);
+			m_batch.draw(tile);
 		}
-		break;
-
-	case GameState::GAME_WIN:
-		// Do nothing for now in the WIN state
-		
-		break;
-
-	case GameState::GAME_LOSE:
-		// Do nothing for now in the LOSE state
-		break;
-
-	default:
-		break;
 	}
-}
-//void Game::setGameState(GameState newState) {
-//	m_currentGameState = newState;
-//}
+	snapshot.m_ai.render(m_batch, m_camera, alpha);
+	snapshot.m_steering.renderDebug(m_camera);
 
-GameState Game::getGameState() const {
-	return m_currentGameState;
-}
+	// The walls are already on the GPU, so whatever is batched must go first to keep the order.
+	m_batch.flush();
+	m_wallLayer.render(m_window);
+	snapshot.m_player.render(m_batch, m_camera, alpha);
+	ProjectilePool::render(snapshot.m_shells, snapshot.m_shellTexture, m_batch, m_camera, alpha);
+	m_batch.flush();
+	DebugDraw::render(m_window);
 
-////////////////////////////////////////////////////////////
-void Game::render()
-{
-	m_window.clear(sf::Color(0, 0, 0, 0));
-	m_window.draw(m_bgSprite);
-	m_aiTank.render(m_window);
+	m_window.setView(m_window.getDefaultView());
+	m_hud.update(snapshot.m_gameState, snapshot.m_aiHealth);
 	m_hud.render(m_window);
-	for (auto const& wall : m_wallSprites)
-	{
-		m_window.draw(wall);
-	}
-	m_tank.render(m_window);
+	m_profilerOverlay.render(m_window);
 #ifdef TEST_FPS
 	m_window.draw(x_updateFPS);
 	m_window.draw(x_drawFPS);
 #endif
-	m_window.display();
 }
 
 
@@ -1,7 +1,8 @@
 #include "HUD.h"
+#include <string>
 
 ////////////////////////////////////////////////////////////
-HUD::HUD(sf::Font& hudFont)
+HUD::HUD(sf::Font& hudFont, sf::Font const & t_healthFont)
     : m_textFont(hudFont)
 {
     m_gameStateText.setFont(hudFont);
@@ -10,6 +11,11 @@ HUD::HUD(sf::Font& hudFont)
     m_gameStateText.setString("Game Running");
     m_gameStateText.setPosition(sf::Vector2f(600 - m_gameStateText.getGlobalBounds().width / 2.0f, 5));
 
+    m_healthText.setFont(t_healthFont);
+    m_healthText.setCharacterSize(30);
+    m_healthText.setFillColor(sf::Color::Red);
+    m_healthText.setPosition(20, 5);
+
     //Setting up our hud properties 
     m_hudOutline.setSize(sf::Vector2f(1440.0f, 40.0f));
     m_hudOutline.setFillColor(sf::Color(0, 0, 0, 38));
@@ -19,8 +25,14 @@ HUD::HUD(sf::Font& hudFont)
 }
 
 ////////////////////////////////////////////////////////////
-void HUD::update(GameState const& gameState)
+void HUD::update(GameState const& gameState, int t_aiHealth)
 {
+    if (t_aiHealth != m_shownHealth)
+    {
+        m_healthText.setString("health : " + std::to_string(t_aiHealth));
+        m_shownHealth = t_aiHealth;
+    }
+
     switch (gameState)
     {
     case GameState::GAME_RUNNING:
@@ -40,6 +52,7 @@ void HUD::render(sf::RenderWindow& window)
 {
     window.draw(m_hudOutline);
     window.draw(m_gameStateText);
+    window.draw(m_healthText);
 }
 
 sf::Text& HUD::getGameStateText()
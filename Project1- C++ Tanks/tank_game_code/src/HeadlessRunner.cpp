@@ -0,0 +1,144 @@
+#include "HeadlessRunner.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+////////////////////////////////////////////////////////////
+HeadlessRunner::HeadlessRunner(InputScript const & t_script, double t_tickRate, int t_maxTicks)
+	: m_script(t_script),
+	m_tickMilliseconds(1000.0 / t_tickRate),
+	m_maxTicks(t_maxTicks)
+{
+	// No texture is created, so nothing here needs an OpenGL context.
+	World::loadAtlas(nullptr);
+}
+
+////////////////////////////////////////////////////////////
+void HeadlessRunner::run(int t_matches)
+{
+	int wins = 0;
+	int losses = 0;
+	int draws = 0;
+	long long totalTicks = 0;
+	double updateSeconds = 0.0;
+
+	Profiler::setThreadName("headless");
+	ZoneStats stats[static_cast<int>(ProfileZone::COUNT)];
+	Profiler::sample(stats);
+
+	auto start = std::chrono::steady_clock::now();
+	for (int match = 0; match < t_matches; ++match)
+	{
+		GameState outcome = GameState::GAME_RUNNING;
+		double seconds = 0.0;
+		InputRecording recording;
+		bool record = match == 0 && !m_recordFile.empty();
+		totalTicks += runMatch(outcome, seconds, record ? &recording : nullptr);
+		updateSeconds += seconds;
+		if (record)
+		{
+			recording.save(m_recordFile);
+			std::cout << "Headless: recorded " << recording.tickCount() << " ticks to " << m_recordFile << std::endl;
+		}
+
+		switch (outcome)
+		{
+		case GameState::GAME_WIN:
+			wins++;
+			break;
+		case GameState::GAME_LOSE:
+			losses++;
+			break;
+		default:
+			draws++;
+			break;
+		}
+	}
+	double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	char summary[512];
+	std::snprintf(summary, sizeof(summary),
+		"Headless: %d matches, %d won, %d lost, %d hit the %d tick limit\n"
+		"Headless: %lld ticks in %.3f s (%.3f s simulating), %.0f ticks/s, %.2f us/tick\n",
+		t_matches, wins, losses, draws, m_maxTicks,
+		totalTicks, totalSeconds, updateSeconds,
+		updateSeconds > 0.0 ? totalTicks / updateSeconds : 0.0,
+		totalTicks > 0 ? updateSeconds * 1000000.0 / totalTicks : 0.0);
+	std::cout << summary;
+
+	// Only the simulation zones are ever entered headless
+	Profiler::sample(stats);
+	for (int zone = 0; zone < static_cast<int>(ProfileZone::COUNT); ++zone)
+	{
+		if (stats[zone].m_callsPerSecond > 0.0)
+		{
+			std::snprintf(summary, sizeof(summary), "Headless: %-26s %9.0f calls/s, mean %.4f ms, max %.4f ms\n",
+				Profiler::zoneName(static_cast<ProfileZone>(zone)), stats[zone].m_callsPerSecond,
+				stats[zone].m_meanMilliseconds, stats[zone].m_maxMilliseconds);
+			std::cout << summary;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void HeadlessRunner::recordTo(std::string const & t_fileName)
+{
+	m_recordFile = t_fileName;
+}
+
+////////////////////////////////////////////////////////////
+bool HeadlessRunner::replay(InputRecording const & t_recording)
+{
+	World world(nullptr);
+	if (world.stateHash() != t_recording.initialHash())
+	{
+		std::cout << "Headless: the replay starts from a different world than was recorded" << std::endl;
+		return false;
+	}
+
+	double tickMilliseconds = 1000.0 / t_recording.tickRate();
+	auto start = std::chrono::steady_clock::now();
+	for (int tick = 0; tick < t_recording.tickCount(); ++tick)
+	{
+		world.update(tickMilliseconds, t_recording.input(tick));
+		if (!t_recording.matches(tick, world.stateHash()))
+		{
+			std::cout << "Headless: the replay diverged from the recording at tick " << tick << std::endl;
+			return false;
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	char summary[256];
+	std::snprintf(summary, sizeof(summary), "Headless: the replay matched all %d ticks in %.3f s\n",
+		t_recording.tickCount(), seconds);
+	std::cout << summary;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+int HeadlessRunner::runMatch(GameState & t_outcome, double & t_seconds, InputRecording * t_recording)
+{
+	World world(nullptr);
+	m_script.restart();
+	if (t_recording != nullptr)
+	{
+		t_recording->begin(1000.0 / m_tickMilliseconds, world.stateHash());
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	int tick = 0;
+	while (tick < m_maxTicks && world.getGameState() == GameState::GAME_RUNNING)
+	{
+		TankInput input = m_script.next();
+		world.update(m_tickMilliseconds, input);
+		if (t_recording != nullptr)
+		{
+			t_recording->add(input, world.stateHash());
+		}
+		tick++;
+	}
+	t_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	t_outcome = world.getGameState();
+	return tick;
+}
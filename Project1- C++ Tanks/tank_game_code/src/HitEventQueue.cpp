@@ -0,0 +1,48 @@
+#include "HitEventQueue.h"
+
+////////////////////////////////////////////////////////////
+HitEventQueue::HitEventQueue(int t_capacity)
+{
+	m_events.reserve(t_capacity);
+}
+
+////////////////////////////////////////////////////////////
+bool HitEventQueue::push(HitEvent const & t_event)
+{
+	if (m_events.size() == m_events.capacity())
+	{
+		return false;
+	}
+	m_events.push_back(t_event);
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void HitEventQueue::clear()
+{
+	m_events.clear();
+}
+
+////////////////////////////////////////////////////////////
+int HitEventQueue::size() const
+{
+	return static_cast<int>(m_events.size());
+}
+
+////////////////////////////////////////////////////////////
+bool HitEventQueue::empty() const
+{
+	return m_events.empty();
+}
+
+////////////////////////////////////////////////////////////
+std::vector<HitEvent>::const_iterator HitEventQueue::begin() const
+{
+	return m_events.begin();
+}
+
+////////////////////////////////////////////////////////////
+std::vector<HitEvent>::const_iterator HitEventQueue::end() const
+{
+	return m_events.end();
+}
@@ -0,0 +1,122 @@
+#include "InputRecording.h"
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+	// Layout of a recording file: this header, tickCount input bytes, then tickCount 64 bit hashes.
+	struct RecordingHeader
+	{
+		std::uint32_t m_magic;
+		std::uint32_t m_version;
+		double m_tickRate;
+		std::uint64_t m_initialHash;
+		std::uint32_t m_tickCount;
+		std::uint32_t m_padding;
+	};
+
+	std::uint32_t const s_RECORDING_MAGIC = 0x43455254; // "TREC"
+	// Bump whenever the layout, TankInput or what the state hash covers changes.
+	std::uint32_t const s_RECORDING_VERSION = 1;
+}
+
+////////////////////////////////////////////////////////////
+void InputRecording::begin(double t_tickRate, std::uint64_t t_initialHash)
+{
+	m_tickRate = t_tickRate;
+	m_initialHash = t_initialHash;
+	m_inputs.clear();
+	m_hashes.clear();
+}
+
+////////////////////////////////////////////////////////////
+void InputRecording::add(TankInput t_input, std::uint64_t t_hash)
+{
+	m_inputs.push_back(t_input.m_controls);
+	m_hashes.push_back(t_hash);
+}
+
+////////////////////////////////////////////////////////////
+void InputRecording::save(std::string const & t_fileName) const
+{
+	RecordingHeader header{};
+	header.m_magic = s_RECORDING_MAGIC;
+	header.m_version = s_RECORDING_VERSION;
+	header.m_tickRate = m_tickRate;
+	header.m_initialHash = m_initialHash;
+	header.m_tickCount = static_cast<std::uint32_t>(m_inputs.size());
+
+	std::ofstream out(t_fileName, std::ios::binary | std::ios::trunc);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(m_inputs.data()), m_inputs.size());
+	out.write(reinterpret_cast<const char*>(m_hashes.data()), m_hashes.size() * sizeof(std::uint64_t));
+	out.close();
+	if (!out)
+	{
+		std::string message("Could not write recording " + t_fileName);
+		throw std::runtime_error(message);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void InputRecording::load(std::string const & t_fileName)
+{
+	std::ifstream in(t_fileName, std::ios::binary);
+	RecordingHeader header{};
+	in.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!in || header.m_magic != s_RECORDING_MAGIC || header.m_version != s_RECORDING_VERSION)
+	{
+		std::string message("File: " + t_fileName + " is not a recording, or from another version");
+		throw std::runtime_error(message);
+	}
+
+	std::vector<std::uint8_t> inputs(header.m_tickCount);
+	std::vector<std::uint64_t> hashes(header.m_tickCount);
+	in.read(reinterpret_cast<char*>(inputs.data()), inputs.size());
+	in.read(reinterpret_cast<char*>(hashes.data()), hashes.size() * sizeof(std::uint64_t));
+	if (!in)
+	{
+		std::string message("File: " + t_fileName + " is truncated");
+		throw std::runtime_error(message);
+	}
+
+	m_tickRate = header.m_tickRate;
+	m_initialHash = header.m_initialHash;
+	m_inputs = std::move(inputs);
+	m_hashes = std::move(hashes);
+}
+
+////////////////////////////////////////////////////////////
+TankInput InputRecording::input(int t_tick) const
+{
+	TankInput input;
+	if (t_tick >= 0 && t_tick < tickCount())
+	{
+		input.m_controls = m_inputs[t_tick];
+	}
+	return input;
+}
+
+////////////////////////////////////////////////////////////
+bool InputRecording::matches(int t_tick, std::uint64_t t_hash) const
+{
+	return t_tick < 0 || t_tick >= tickCount() || m_hashes[t_tick] == t_hash;
+}
+
+////////////////////////////////////////////////////////////
+int InputRecording::tickCount() const
+{
+	return static_cast<int>(m_inputs.size());
+}
+
+////////////////////////////////////////////////////////////
+double InputRecording::tickRate() const
+{
+	return m_tickRate;
+}
+
+////////////////////////////////////////////////////////////
+std::uint64_t InputRecording::initialHash() const
+{
+	return m_initialHash;
+}
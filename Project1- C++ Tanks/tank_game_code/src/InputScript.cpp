@@ -0,0 +1,68 @@
+#include "InputScript.h"
+#include "yaml-cpp/yaml.h"
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////
+void InputScript::load(std::string const & t_fileName)
+{
+	std::vector<Step> steps;
+	try
+	{
+		YAML::Node baseNode = YAML::LoadFile(t_fileName);
+		YAML::Node const & stepsNode = baseNode["steps"];
+		for (unsigned i = 0; i < stepsNode.size(); ++i)
+		{
+			Step step;
+			step.m_ticks = stepsNode[i]["ticks"].as<int>();
+			YAML::Node const & controlsNode = stepsNode[i]["controls"];
+			for (unsigned j = 0; j < controlsNode.size(); ++j)
+			{
+				std::string name = controlsNode[j].as<std::string>();
+				std::uint8_t control = TankInput::controlNamed(name.c_str());
+				if (control == 0)
+				{
+					std::string message("Unknown control " + name);
+					throw std::runtime_error(message);
+				}
+				step.m_input.m_controls |= control;
+			}
+			if (step.m_ticks > 0)
+			{
+				steps.push_back(step);
+			}
+		}
+	}
+	catch (YAML::Exception& e)
+	{
+		std::string message(e.what());
+		message = "YAML Parser Error in " + t_fileName + ": " + message;
+		throw std::runtime_error(message);
+	}
+
+	m_steps = std::move(steps);
+	restart();
+}
+
+////////////////////////////////////////////////////////////
+TankInput InputScript::next()
+{
+	if (m_steps.empty())
+	{
+		return TankInput();
+	}
+
+	TankInput input = m_steps[m_step].m_input;
+	if (++m_tick == m_steps[m_step].m_ticks)
+	{
+		m_tick = 0;
+		m_step = (m_step + 1) % static_cast<int>(m_steps.size());
+	}
+	return input;
+}
+
+////////////////////////////////////////////////////////////
+void InputScript::restart()
+{
+	m_step = 0;
+	m_tick = 0;
+}
@@ -1,4 +1,6 @@
 #include "LevelLoader.h"
+#include <stdexcept>
+#include <string>
 //
 /// The various operator >> overloads below are non-member functions used to extract
 ///  the game data from the YAML data structure.
@@ -30,6 +32,47 @@ void operator >> (const YAML::Node& t_backgroundNode, BackgroundData& t_backgrou
 	t_background.m_fileName = t_backgroundNode["file"].as<std::string>();
 }
 
+/// <summary>
+/// @brief Extracts the speed, lifetime and damage of a projectile archetype.
+/// A shell's heading is recovered from its velocity, so a speed that is not positive is rejected.
+/// </summary>
+/// <param name="t_projectileNode">A YAML node</param>
+/// <param name="t_projectile">A simple struct to store the projectile data</param>
+////////////////////////////////////////////////////////////
+void operator >> (const YAML::Node& t_projectileNode, ProjectileData& t_projectile)
+{
+	t_projectile.m_speed = t_projectileNode["speed"].as<float>();
+	if (!(t_projectile.m_speed > 0.0f))
+	{
+		throw std::runtime_error("Projectile speed must be greater than 0, got " + t_projectileNode["speed"].as<std::string>());
+	}
+	t_projectile.m_lifetime = t_projectileNode["lifetime"].as<float>();
+	t_projectile.m_damage = t_projectileNode["damage"].as<int>();
+}
+
+/// <summary>
+/// @brief Extracts the weapon of a tank: how many shells it can have in flight,
+///  the time between shots and the projectile it fires.
+/// A tank must be able to have at least one shell in flight, and the reload time cannot be negative.
+/// </summary>
+/// <param name="t_tankNode">A YAML node of a tank</param>
+/// <param name="t_weapon">A simple struct to store the weapon data</param>
+////////////////////////////////////////////////////////////
+void operator >> (const YAML::Node& t_tankNode, WeaponData& t_weapon)
+{
+	t_weapon.m_maxProjectiles = t_tankNode["max_projectiles"].as<int>();
+	if (t_weapon.m_maxProjectiles < 1)
+	{
+		throw std::runtime_error("max_projectiles must be at least 1, got " + std::to_string(t_weapon.m_maxProjectiles));
+	}
+	t_weapon.m_reloadTime = t_tankNode["reload_time"].as<int>();
+	if (t_weapon.m_reloadTime < 0)
+	{
+		throw std::runtime_error("reload_time cannot be negative, got " + std::to_string(t_weapon.m_reloadTime));
+	}
+	t_tankNode["projectile"] >> t_weapon.m_projectile;
+}
+
 /// <summary>
 /// @brief Extracts the initial screen position for the player tank.
 /// 
@@ -42,6 +85,7 @@ void operator >> (const YAML::Node& t_tankNode, TankData& t_tank)
 	t_tank.m_position.x = t_tankNode["position"]["x"].as<float>();
 	t_tank.m_position.y = t_tankNode["position"]["y"].as<float>();
 	t_tank.m_scale = t_tankNode["scale"].as<float>();
+	t_tankNode >> t_tank.m_weapon;
 }
 /// <summary>
 /// @brief Extracts the initial screen position for the AI tank.
@@ -56,8 +100,7 @@ void operator >> (const YAML::Node& t_tankNode, AITankData& t_aiTank)
 	t_aiTank.m_position.y = t_tankNode["position"]["y"].as<float>();
 	t_aiTank.m_scale.x = t_tankNode["scale"]["x"].as<float>();
 	t_aiTank.m_scale.y = t_tankNode["scale"]["y"].as<float>();
-	t_aiTank.m_maxProjectiles = t_tankNode["max_projectiles"].as<int>();
-	t_aiTank.m_reloadTime = t_tankNode["reload_time"].as<int>();
+	t_tankNode >> t_aiTank.m_weapon;
 }
 /// <summary>
 /// @brief Top level function that extracts various game data from the YAML data stucture.
@@ -99,7 +142,7 @@ void LevelLoader::load(int t_levelNr, LevelData& t_level)
 		if (baseNode.IsNull())
 		{
 			std::string message("File: " + filename + " not found");
-			throw std::exception(message.c_str());
+			throw std::runtime_error(message);
 		}
 		baseNode >> t_level;
 	}
@@ -107,13 +150,13 @@ void LevelLoader::load(int t_levelNr, LevelData& t_level)
 	{
 		std::string message(e.what());
 		message = "YAML Parser Error: " + message;
-		throw std::exception(message.c_str());
+		throw std::runtime_error(message);
 	}
 	catch (std::exception& e)
 	{
 		std::string message(e.what());
 		message = "Unexpected Error: " + message;
-		throw std::exception(message.c_str());
+		throw std::runtime_error(message);
 	}
 }
 
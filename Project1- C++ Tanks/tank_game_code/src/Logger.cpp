@@ -0,0 +1,222 @@
+#include "Logger.h"
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+namespace
+{
+	int const s_OFF = static_cast<int>(LogLevel::OFF);
+
+	char const * const s_LEVEL_NAMES[] = { "TRACE", "DEBUG", "INFO", "WARNING", "CRITICAL", "OFF" };
+	char const * const s_CATEGORY_NAMES[] = { "general", "ai", "combat", "collision", "level", "render" };
+
+	// How long the writer sleeps when there is nothing to write.
+	std::chrono::milliseconds const s_IDLE_SLEEP{ 5 };
+
+	////////////////////////////////////////////////////////////
+	void appendArg(std::string & t_line, LogArg const & t_arg)
+	{
+		char number[32];
+		switch (t_arg.m_type)
+		{
+		case LogArg::Type::INTEGER:
+			std::snprintf(number, sizeof(number), "%lld", t_arg.m_integer);
+			t_line += number;
+			break;
+		case LogArg::Type::REAL:
+			std::snprintf(number, sizeof(number), "%g", t_arg.m_real);
+			t_line += number;
+			break;
+		case LogArg::Type::TEXT:
+			t_line += t_arg.m_text != nullptr ? t_arg.m_text : "(null)";
+			break;
+		}
+	}
+}
+
+std::atomic<int> Logger::s_levels[static_cast<int>(LogCategory::COUNT)] = { s_OFF, s_OFF, s_OFF, s_OFF, s_OFF, s_OFF };
+Logger::Record Logger::s_ring[Logger::s_CAPACITY];
+std::atomic<std::size_t> Logger::s_enqueuePosition{ 0 };
+std::size_t Logger::s_dequeuePosition{ 0 };
+std::atomic<std::size_t> Logger::s_dropped{ 0 };
+std::atomic<int> Logger::s_producers{ 0 };
+std::atomic<bool> Logger::s_running{ false };
+std::thread Logger::s_writer;
+std::chrono::steady_clock::time_point Logger::s_startTime;
+
+////////////////////////////////////////////////////////////
+void Logger::start(LogLevel t_level)
+{
+	if (s_running)
+	{
+		return;
+	}
+
+	// Slot i is free for the record at position i. Nothing can be logged yet, as every category is OFF.
+	for (std::size_t i = 0; i < s_CAPACITY; ++i)
+	{
+		s_ring[i].m_sequence.store(i, std::memory_order_relaxed);
+	}
+	s_enqueuePosition.store(0, std::memory_order_relaxed);
+	s_dequeuePosition = 0;
+	s_startTime = std::chrono::steady_clock::now();
+
+	s_running = true;
+	s_writer = std::thread(&Logger::run);
+
+	for (std::atomic<int> & level : s_levels)
+	{
+		level.store(static_cast<int>(t_level), std::memory_order_relaxed);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void Logger::stop()
+{
+	if (!s_running)
+	{
+		return;
+	}
+	for (std::atomic<int> & level : s_levels)
+	{
+		level.store(s_OFF, std::memory_order_relaxed);
+	}
+	s_running = false;
+
+	// A thread that checked its level before it was turned off may still be filling a slot.
+	// Once s_running is false no new push() gets past its check, so this count only falls.
+	while (s_producers.load() != 0)
+	{
+		std::this_thread::yield();
+	}
+	s_writer.join();
+
+	// The writer's last drain may have run before those records were published.
+	drain();
+}
+
+////////////////////////////////////////////////////////////
+void Logger::setLevel(LogCategory t_category, LogLevel t_level)
+{
+	s_levels[static_cast<int>(t_category)].store(static_cast<int>(t_level), std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////
+void Logger::push(LogLevel t_level, LogCategory t_category, char const * t_format, LogArg const * t_args, int t_argCount)
+{
+	s_producers.fetch_add(1);
+	if (!s_running.load())
+	{
+		s_producers.fetch_sub(1);
+		return;
+	}
+
+	// A bounded multiple producer queue: each slot's sequence says which position may fill it next.
+	std::size_t position = s_enqueuePosition.load(std::memory_order_relaxed);
+	Record * record;
+	for (;;)
+	{
+		record = &s_ring[position & (s_CAPACITY - 1)];
+		std::size_t sequence = record->m_sequence.load(std::memory_order_acquire);
+		std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+		if (difference == 0)
+		{
+			if (s_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (difference < 0)
+		{
+			// The slot still holds a record from the previous lap: the ring is full.
+			s_dropped.fetch_add(1, std::memory_order_relaxed);
+			s_producers.fetch_sub(1);
+			return;
+		}
+		else
+		{
+			position = s_enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	record->m_time = std::chrono::steady_clock::now();
+	record->m_level = t_level;
+	record->m_category = t_category;
+	record->m_format = t_format;
+	record->m_argCount = t_argCount;
+	for (int i = 0; i < t_argCount; ++i)
+	{
+		record->m_args[i] = t_args[i];
+	}
+	record->m_sequence.store(position + 1, std::memory_order_release);
+	s_producers.fetch_sub(1);
+}
+
+////////////////////////////////////////////////////////////
+void Logger::run()
+{
+	while (s_running.load())
+	{
+		if (drain() == 0)
+		{
+			std::this_thread::sleep_for(s_IDLE_SLEEP);
+		}
+	}
+	drain();
+}
+
+////////////////////////////////////////////////////////////
+int Logger::drain()
+{
+	std::string text;
+	int written = 0;
+
+	for (;;)
+	{
+		Record & record = s_ring[s_dequeuePosition & (s_CAPACITY - 1)];
+		if (record.m_sequence.load(std::memory_order_acquire) != s_dequeuePosition + 1)
+		{
+			break;
+		}
+
+		double seconds = std::chrono::duration<double>(record.m_time - s_startTime).count();
+		char prefix[64];
+		std::snprintf(prefix, sizeof(prefix), "%9.3f [%s][%s] ", seconds,
+			s_LEVEL_NAMES[static_cast<int>(record.m_level)], s_CATEGORY_NAMES[static_cast<int>(record.m_category)]);
+		text += prefix;
+
+		// Replace each {} with the next argument; extra placeholders are kept as they are.
+		int arg = 0;
+		for (char const * c = record.m_format; *c != '\0'; ++c)
+		{
+			if (c[0] == '{' && c[1] == '}' && arg < record.m_argCount)
+			{
+				appendArg(text, record.m_args[arg++]);
+				++c;
+			}
+			else
+			{
+				text += *c;
+			}
+		}
+		text += '\n';
+
+		// Hand the slot back to the producers, for the record one lap later.
+		record.m_sequence.store(s_dequeuePosition + s_CAPACITY, std::memory_order_release);
+		s_dequeuePosition++;
+		written++;
+	}
+
+	std::size_t dropped = s_dropped.exchange(0, std::memory_order_relaxed);
+	if (dropped > 0)
+	{
+		text += "Logger: " + std::to_string(dropped) + " records dropped, the ring buffer was full\n";
+	}
+
+	if (!text.empty())
+	{
+		std::cout << text;
+		std::cout.flush();
+	}
+	return written;
+}
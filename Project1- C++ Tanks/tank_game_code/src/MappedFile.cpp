@@ -0,0 +1,117 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+////////////////////////////////////////////////////////////
+bool MappedFile::open(std::string const & t_path)
+{
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(t_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	void * view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	m_file = file;
+	m_mapping = mapping;
+	m_data = static_cast<unsigned char const *>(view);
+	m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+	int file = ::open(t_path.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+
+	struct stat status;
+	if (fstat(file, &status) != 0 || status.st_size == 0)
+	{
+		::close(file);
+		return false;
+	}
+
+	void * view = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+	// The mapping stays valid once the descriptor is closed.
+	::close(file);
+	if (view == MAP_FAILED)
+	{
+		return false;
+	}
+
+	m_data = static_cast<unsigned char const *>(view);
+	m_size = static_cast<std::size_t>(status.st_size);
+#endif
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void MappedFile::close()
+{
+	if (m_data == nullptr)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_data);
+	CloseHandle(static_cast<HANDLE>(m_mapping));
+	CloseHandle(static_cast<HANDLE>(m_file));
+	m_mapping = nullptr;
+	m_file = nullptr;
+#else
+	munmap(const_cast<unsigned char *>(m_data), m_size);
+#endif
+	m_data = nullptr;
+	m_size = 0;
+}
+
+////////////////////////////////////////////////////////////
+unsigned char const * MappedFile::data() const
+{
+	return m_data;
+}
+
+////////////////////////////////////////////////////////////
+std::size_t MappedFile::size() const
+{
+	return m_size;
+}
@@ -1,4 +1,5 @@
 #include "MathUtility.h"
+#include <cmath>
 
 namespace MathUtility
 {
@@ -33,6 +34,28 @@ namespace MathUtility
 
 		return currentRotation + angleDiff;
 	}
+	////////////////////////////////////////////////////////////
+	float lerpAngle(float from, float to, float alpha)
+	{
+		float angleDiff = std::fmod(to - from, 360.0f);
+		if (angleDiff > 180.0f) {
+			angleDiff -= 360.0f;
+		}
+		else if (angleDiff < -180.0f) {
+			angleDiff += 360.0f;
+		}
+		return from + angleDiff * alpha;
+	}
+
+	////////////////////////////////////////////////////////////
+	sf::Sprite interpolate(sf::Sprite const & current, sf::Transformable const & previous, float alpha)
+	{
+		sf::Sprite sprite(current);
+		sprite.setPosition(previous.getPosition() + (current.getPosition() - previous.getPosition()) * alpha);
+		sprite.setRotation(lerpAngle(previous.getRotation(), current.getRotation(), alpha));
+		return sprite;
+	}
+
 	////////////////////////////////////////////////////////////
 	sf::Vector2f truncate(sf::Vector2f v, float const max)
 	{		
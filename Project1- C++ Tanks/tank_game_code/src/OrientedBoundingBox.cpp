@@ -15,7 +15,7 @@ OrientedBoundingBox::OrientedBoundingBox(const sf::Sprite& Object) // Calculate
 	Points[3] = trans.transformPoint(0.f, height);
 }
 
-void OrientedBoundingBox::ProjectOntoAxis(const sf::Vector2f& Axis, float& Min, float& Max) // Project all four points of the OBB onto the given axis and return the dotproducts of the two outermost points
+void OrientedBoundingBox::ProjectOntoAxis(const sf::Vector2f& Axis, float& Min, float& Max) const // Project all four points of the OBB onto the given axis and return the dotproducts of the two outermost points
 {
 	Min = (Points[0].x*Axis.x + Points[0].y*Axis.y);
 	Max = Min;
@@ -28,4 +28,70 @@ void OrientedBoundingBox::ProjectOntoAxis(const sf::Vector2f& Axis, float& Min,
 		if (Projection>Max)
 			Max = Projection;
 	}
-}
\ No newline at end of file
+}
+
+StaticCollider::StaticCollider(const sf::Sprite& Object) // Calculate the points, edge axes and projections of the OBB once
+{
+	OrientedBoundingBox OBB(Object);
+	for (int i = 0; i<4; i++)
+		Points[i] = OBB.Points[i];
+
+	// Same axes (and order) as CollisionDetector::collision() uses for its second object
+	Axes[0] = sf::Vector2f(Points[0].x - Points[3].x, Points[0].y - Points[3].y);
+	Axes[1] = sf::Vector2f(Points[0].x - Points[1].x, Points[0].y - Points[1].y);
+
+	for (int i = 0; i<2; i++)
+		ProjectOntoAxis(Axes[i], Min[i], Max[i]);
+}
+
+void StaticCollider::ProjectOntoAxis(const sf::Vector2f& Axis, float& Min, float& Max) const // Project all four points of the OBB onto the given axis and return the dotproducts of the two outermost points
+{
+	Min = (Points[0].x*Axis.x + Points[0].y*Axis.y);
+	Max = Min;
+	for (int j = 1; j<4; j++)
+	{
+		float Projection = (Points[j].x*Axis.x + Points[j].y*Axis.y);
+
+		if (Projection<Min)
+			Min = Projection;
+		if (Projection>Max)
+			Max = Projection;
+	}
+}
+
+void ObbBatch::Add(const StaticCollider& Box) // Append a box; its index is the number of boxes added before it
+{
+	for (int i = 0; i<4; i++)
+	{
+		X[i].push_back(Box.Points[i].x);
+		Y[i].push_back(Box.Points[i].y);
+	}
+	for (int i = 0; i<2; i++)
+	{
+		AxisX[i].push_back(Box.Axes[i].x);
+		AxisY[i].push_back(Box.Axes[i].y);
+		Min[i].push_back(Box.Min[i]);
+		Max[i].push_back(Box.Max[i]);
+	}
+}
+
+void ObbBatch::Clear()
+{
+	for (int i = 0; i<4; i++)
+	{
+		X[i].clear();
+		Y[i].clear();
+	}
+	for (int i = 0; i<2; i++)
+	{
+		AxisX[i].clear();
+		AxisY[i].clear();
+		Min[i].clear();
+		Max[i].clear();
+	}
+}
+
+int ObbBatch::Count() const
+{
+	return static_cast<int>(X[0].size());
+}
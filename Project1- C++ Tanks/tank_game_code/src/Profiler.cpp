@@ -0,0 +1,152 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+	char const * const s_ZONE_NAMES[] =
+	{
+		"World::update",
+		"Tank::update",
+		"ProjectilePool::update",
+		"Tank::checkWallCollision",
+		"AITank::update",
+		"World::updateBroadphase",
+		"Game::render"
+	};
+
+	////////////////////////////////////////////////////////////
+	double toMicroseconds(std::chrono::steady_clock::duration t_duration)
+	{
+		return std::chrono::duration<double, std::micro>(t_duration).count();
+	}
+}
+
+std::atomic<bool> Profiler::s_enabled{ true };
+Profiler::ZoneTotals Profiler::s_totals[static_cast<int>(ProfileZone::COUNT)];
+std::mutex Profiler::s_buffersMutex;
+std::vector<std::unique_ptr<Profiler::ThreadBuffer>> Profiler::s_buffers;
+std::chrono::steady_clock::time_point const Profiler::s_startTime = std::chrono::steady_clock::now();
+std::chrono::steady_clock::time_point Profiler::s_lastSample = std::chrono::steady_clock::now();
+std::uint64_t Profiler::s_lastCalls[static_cast<int>(ProfileZone::COUNT)] = {};
+std::uint64_t Profiler::s_lastNanoseconds[static_cast<int>(ProfileZone::COUNT)] = {};
+
+////////////////////////////////////////////////////////////
+void Profiler::setEnabled(bool t_enabled)
+{
+	s_enabled.store(t_enabled, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////
+void Profiler::setThreadName(char const * t_name)
+{
+	threadBuffer().m_name = t_name;
+}
+
+////////////////////////////////////////////////////////////
+Profiler::ThreadBuffer & Profiler::threadBuffer()
+{
+	thread_local ThreadBuffer * buffer = nullptr;
+	if (buffer == nullptr)
+	{
+		std::unique_ptr<ThreadBuffer> created(new ThreadBuffer());
+		created->m_events.resize(s_EVENTS_PER_THREAD);
+		buffer = created.get();
+
+		std::lock_guard<std::mutex> lock(s_buffersMutex);
+		buffer->m_id = static_cast<int>(s_buffers.size()) + 1;
+		s_buffers.push_back(std::move(created));
+	}
+	return *buffer;
+}
+
+////////////////////////////////////////////////////////////
+void Profiler::record(ProfileZone t_zone, std::chrono::steady_clock::time_point t_start,
+	std::chrono::steady_clock::time_point t_end)
+{
+	ThreadBuffer & buffer = threadBuffer();
+	buffer.m_events[buffer.m_written % s_EVENTS_PER_THREAD] = Event{ t_zone, t_start, t_end };
+	buffer.m_written++;
+
+	std::uint64_t nanoseconds = static_cast<std::uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_start).count());
+	ZoneTotals & totals = s_totals[static_cast<int>(t_zone)];
+	totals.m_calls.fetch_add(1, std::memory_order_relaxed);
+	totals.m_nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+	std::uint64_t longest = totals.m_maxNanoseconds.load(std::memory_order_relaxed);
+	while (nanoseconds > longest
+		&& !totals.m_maxNanoseconds.compare_exchange_weak(longest, nanoseconds, std::memory_order_relaxed))
+	{
+	}
+}
+
+////////////////////////////////////////////////////////////
+void Profiler::sample(ZoneStats (&t_stats)[static_cast<int>(ProfileZone::COUNT)])
+{
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	double seconds = std::max(std::chrono::duration<double>(now - s_lastSample).count(), 1e-6);
+	s_lastSample = now;
+
+	for (int zone = 0; zone < static_cast<int>(ProfileZone::COUNT); ++zone)
+	{
+		ZoneTotals & totals = s_totals[zone];
+		std::uint64_t calls = totals.m_calls.load(std::memory_order_relaxed);
+		std::uint64_t nanoseconds = totals.m_nanoseconds.load(std::memory_order_relaxed);
+		std::uint64_t longest = totals.m_maxNanoseconds.exchange(0, std::memory_order_relaxed);
+
+		std::uint64_t windowCalls = calls - s_lastCalls[zone];
+		std::uint64_t windowNanoseconds = nanoseconds - s_lastNanoseconds[zone];
+		s_lastCalls[zone] = calls;
+		s_lastNanoseconds[zone] = nanoseconds;
+
+		t_stats[zone].m_callsPerSecond = windowCalls / seconds;
+		t_stats[zone].m_meanMilliseconds = windowCalls > 0 ? windowNanoseconds / 1000000.0 / windowCalls : 0.0;
+		t_stats[zone].m_maxMilliseconds = longest / 1000000.0;
+	}
+}
+
+////////////////////////////////////////////////////////////
+char const * Profiler::zoneName(ProfileZone t_zone)
+{
+	return s_ZONE_NAMES[static_cast<int>(t_zone)];
+}
+
+////////////////////////////////////////////////////////////
+bool Profiler::writeChromeTrace(std::string const & t_fileName)
+{
+	std::ofstream out(t_fileName, std::ios::trunc);
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	char line[256];
+	bool first = true;
+	std::lock_guard<std::mutex> lock(s_buffersMutex);
+	for (std::unique_ptr<ThreadBuffer> const & buffer : s_buffers)
+	{
+		if (buffer->m_name != nullptr)
+		{
+			std::snprintf(line, sizeof(line),
+				"%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+				first ? "" : ",\n", buffer->m_id, buffer->m_name);
+			out << line;
+			first = false;
+		}
+
+		// Oldest first; once the ring has wrapped the oldest events are gone.
+		std::size_t count = std::min(buffer->m_written, s_EVENTS_PER_THREAD);
+		for (std::size_t i = buffer->m_written - count; i < buffer->m_written; ++i)
+		{
+			Event const & event = buffer->m_events[i % s_EVENTS_PER_THREAD];
+			std::snprintf(line, sizeof(line),
+				"%s{\"ph\":\"X\",\"cat\":\"game\",\"name\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+				first ? "" : ",\n", zoneName(event.m_zone), buffer->m_id,
+				toMicroseconds(event.m_start - s_startTime), toMicroseconds(event.m_end - event.m_start));
+			out << line;
+			first = false;
+		}
+	}
+
+	out << "\n]}\n";
+	out.close();
+	return static_cast<bool>(out);
+}
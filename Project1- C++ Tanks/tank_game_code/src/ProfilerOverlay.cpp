@@ -0,0 +1,89 @@
+#include "ProfilerOverlay.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+////////////////////////////////////////////////////////////
+ProfilerOverlay::ProfilerOverlay(sf::Font const & t_font)
+{
+	float const columnX[s_COLUMNS] = { 20.0f, 250.0f, 340.0f, 430.0f };
+	for (int column = 0; column < s_COLUMNS; ++column)
+	{
+		m_columns[column].setFont(t_font);
+		m_columns[column].setCharacterSize(18);
+		m_columns[column].setFillColor(sf::Color::White);
+		m_columns[column].setPosition(columnX[column], 60.0f);
+	}
+	m_background.setFillColor(sf::Color(0, 0, 0, 160));
+	m_background.setPosition(10.0f, 55.0f);
+}
+
+////////////////////////////////////////////////////////////
+void ProfilerOverlay::setVisible(bool t_visible)
+{
+	m_visible = t_visible;
+	m_sampleClock.restart();
+	if (m_visible)
+	{
+		// Start a fresh window rather than averaging over the time spent hidden
+		ZoneStats stats[static_cast<int>(ProfileZone::COUNT)];
+		Profiler::sample(stats);
+		for (sf::Text & column : m_columns)
+		{
+			column.setString("");
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool ProfilerOverlay::isVisible() const
+{
+	return m_visible;
+}
+
+////////////////////////////////////////////////////////////
+void ProfilerOverlay::render(sf::RenderWindow & t_window)
+{
+	if (!m_visible)
+	{
+		return;
+	}
+
+	if (m_sampleClock.getElapsedTime().asSeconds() >= s_SAMPLE_SECONDS)
+	{
+		m_sampleClock.restart();
+		ZoneStats stats[static_cast<int>(ProfileZone::COUNT)];
+		Profiler::sample(stats);
+
+		std::string columns[s_COLUMNS] = { "zone\n", "calls/s\n", "mean ms\n", "max ms\n" };
+		char number[32];
+		for (int zone = 0; zone < static_cast<int>(ProfileZone::COUNT); ++zone)
+		{
+			columns[0] += Profiler::zoneName(static_cast<ProfileZone>(zone));
+			columns[0] += '\n';
+			std::snprintf(number, sizeof(number), "%.0f\n", stats[zone].m_callsPerSecond);
+			columns[1] += number;
+			std::snprintf(number, sizeof(number), "%.3f\n", stats[zone].m_meanMilliseconds);
+			columns[2] += number;
+			std::snprintf(number, sizeof(number), "%.3f\n", stats[zone].m_maxMilliseconds);
+			columns[3] += number;
+		}
+
+		float right = 0.0f;
+		float bottom = 0.0f;
+		for (int column = 0; column < s_COLUMNS; ++column)
+		{
+			m_columns[column].setString(columns[column]);
+			sf::FloatRect bounds = m_columns[column].getGlobalBounds();
+			right = std::max(right, bounds.left + bounds.width);
+			bottom = std::max(bottom, bounds.top + bounds.height);
+		}
+		m_background.setSize(sf::Vector2f(right + 10.0f, bottom + 10.0f) - m_background.getPosition());
+	}
+
+	t_window.draw(m_background);
+	for (sf::Text const & column : m_columns)
+	{
+		t_window.draw(column);
+	}
+}
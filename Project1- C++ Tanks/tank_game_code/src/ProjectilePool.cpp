@@ -1,55 +1,370 @@
 #include "ProjectilePool.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+const sf::IntRect ProjectilePool::s_PROJECTILE_RECT{ 298, 154, 24, 10 };
 
 ////////////////////////////////////////////////////////////
-void ProjectilePool::create(sf::Texture const & t_texture, double t_x, double t_y, double t_rotation)
+ProjectilePool::ProjectilePool(int t_capacity, ProjectileData const & t_archetype, OverflowPolicy t_policy)
+	: m_archetype(t_archetype), m_policy(t_policy)
 {
-	// If no projectiles available, simply re-use the next in sequence.
-	if (m_poolFull)
+	// Headings are recovered from velocities, so a shell must move.
+	if (!(m_archetype.m_speed > 0.0f))
+	{
+		throw std::invalid_argument("ProjectilePool: projectile speed must be greater than 0");
+	}
+	if (t_capacity < 1)
 	{
-		m_nextAvailable = (m_nextAvailable + 1) % s_POOL_SIZE;
+		throw std::invalid_argument("ProjectilePool: capacity must be at least 1");
 	}
-	
-	m_projectiles.at(m_nextAvailable).init(t_texture, t_x, t_y, t_rotation);
+	setCapacity(t_capacity);
 }
 
-////////////////////////////////////////////////////////////t_
-void ProjectilePool::update(double t_dt, std::vector<sf::Sprite> & t_wallSprites, sf::Sprite t_base, std::function<void(int)> t_funcApplyDamage)
-{	
-	// The number of active projectiles.
-	int activeCount = 0;
-	// Assume the pool is not full initially.
-	m_poolFull = false;
-	for (int i = 0; i < s_POOL_SIZE; i++)
+////////////////////////////////////////////////////////////
+int ProjectilePool::create(sf::Texture const * t_texture, double t_x, double t_y, double t_rotation)
+{
+	if (m_firstFree < 0)
 	{
-		// If m_projectiles.at(i).update() returns true, then this projectile is onscreen
-		// Note how the condition is negated (i.e. checking if projectile is not in use)
-		if( !m_projectiles.at(i).update(t_dt, t_wallSprites, t_base, t_funcApplyDamage))
+		switch (m_policy)
 		{
-			// If this projectile has expired, make it the next available.
-			m_nextAvailable = i;
+		case OverflowPolicy::REFUSE:
+			return -1;
+		case OverflowPolicy::GROW:
+			setCapacity(capacity() * 2);
+			break;
+		case OverflowPolicy::EVICT_OLDEST:
+			removeAt(m_index[m_oldestSlot]);
+			break;
+		}
+	}
+
+	// Pop a slot off the free list and append the shell to the dense arrays.
+	int slot = m_firstFree;
+	m_firstFree = m_nextFree[slot];
+	int index = m_activeCount++;
+	m_index[slot] = index;
+	m_slot[index] = slot;
+
+	// The new shell is the youngest in flight.
+	m_olderSlot[slot] = m_newestSlot;
+	m_newerSlot[slot] = -1;
+	if (m_newestSlot >= 0)
+	{
+		m_newerSlot[m_newestSlot] = slot;
+	}
+	else
+	{
+		m_oldestSlot = slot;
+	}
+	m_newestSlot = slot;
+
+	double radians = MathUtility::DEG_TO_RAD * t_rotation;
+	m_x[index] = static_cast<float>(t_x);
+	m_y[index] = static_cast<float>(t_y);
+	m_previousX[index] = m_x[index];
+	m_previousY[index] = m_y[index];
+	m_vx[index] = static_cast<float>(std::cos(radians)) * m_archetype.m_speed;
+	m_vy[index] = static_cast<float>(std::sin(radians)) * m_archetype.m_speed;
+	m_lifetime[index] = m_archetype.m_lifetime;
+	m_texture = t_texture;
+	return slot;
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::update(double t_dt, WallGrid const & t_wallGrid)
+{
+	PROFILE_SCOPE(ProfileZone::PROJECTILES);
+	float seconds = static_cast<float>(t_dt / 1000);
+
+	// Integrate every shell in flight in one branch free loop over the dense arrays.
+	for (int i = 0; i < m_activeCount; i++)
+	{
+		m_newX[i] = m_x[i] + m_vx[i] * seconds;
+		m_newY[i] = m_y[i] + m_vy[i] * seconds;
+		m_lifetime[i] -= seconds;
+	}
+
+	for (int i = 0; i < m_activeCount;)
+	{
+		bool hitWall = sweepWalls(i, t_wallGrid);
+		m_x[i] = m_newX[i];
+		m_y[i] = m_newY[i];
+
+		if (hitWall || !isInWorld(m_x[i], m_y[i]) || m_lifetime[i] <= 0.0f)
+		{
+			// The last shell moves into this index and is updated next.
+			removeAt(i);
 		}
 		else
 		{
-			// So we know how many projectiles are active.
-			activeCount++;
+			i++;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool ProjectilePool::sweepWalls(int t_index, WallGrid const & t_wallGrid)
+{
+	sf::Vector2f position(m_x[t_index], m_y[t_index]);
+	sf::Vector2f newPos(m_newX[t_index], m_newY[t_index]);
+	sf::Vector2f heading(m_vx[t_index] / m_archetype.m_speed, m_vy[t_index] / m_archetype.m_speed);
+
+	// Sweep the nose of the shell along its path this frame, so it cannot tunnel through a wall
+	//  between two updates. The shell is treated as a circle of half its height.
+	float halfLength = s_PROJECTILE_RECT.width / 2.0f;
+	sf::Vector2f noseFrom = position + heading * halfLength;
+	sf::Vector2f noseTo = newPos + heading * halfLength;
+	float radius = s_PROJECTILE_RECT.height / 2.0f;
+
+	sf::FloatRect pathBounds(std::min(noseFrom.x, noseTo.x) - radius, std::min(noseFrom.y, noseTo.y) - radius,
+		std::abs(noseTo.x - noseFrom.x) + 2 * radius, std::abs(noseTo.y - noseFrom.y) + 2 * radius);
+
+	float firstImpact = 1.0f;
+	bool hitWall = false;
+	t_wallGrid.forEachNear(pathBounds, [&](int t_wall)
+	{
+		float timeOfImpact;
+		if (CollisionDetector::sweep(noseFrom, noseTo, radius, t_wallGrid.collider(t_wall), timeOfImpact)
+			&& timeOfImpact <= firstImpact)
+		{
+			firstImpact = timeOfImpact;
+			hitWall = true;
 		}
+		return false;
+	});
+
+	if (hitWall)
+	{
+		// Stop the shell exactly where its nose first touched the wall.
+		newPos = position + (noseTo - noseFrom) * firstImpact;
+		m_newX[t_index] = newPos.x;
+		m_newY[t_index] = newPos.y;
 	}
-	// If no projectiles available, set a flag.
-	if (s_POOL_SIZE == activeCount)
-	{		
-		m_poolFull = true;
+	return hitWall;
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::storePreviousState()
+{
+	std::copy(m_x.begin(), m_x.begin() + m_activeCount, m_previousX.begin());
+	std::copy(m_y.begin(), m_y.begin() + m_activeCount, m_previousY.begin());
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::snapshot(std::vector<ShellSnapshot> & t_shells) const
+{
+	t_shells.clear();
+	for (int i = 0; i < m_activeCount; i++)
+	{
+		t_shells.push_back(ShellSnapshot{ m_previousX[i], m_previousY[i], m_x[i], m_y[i],
+			m_vx[i] / m_archetype.m_speed, m_vy[i] / m_archetype.m_speed });
 	}
 }
 
 ////////////////////////////////////////////////////////////
-void ProjectilePool::render(sf::RenderWindow & t_window)
+void ProjectilePool::hash(StateHash & t_hash) const
 {
-	for (int i = 0; i < s_POOL_SIZE; i++)
+	t_hash.add(m_activeCount);
+	for (int i = 0; i < m_activeCount; i++)
 	{
-		// If projectile is active...
-		if (m_projectiles.at(i).inUse())
+		t_hash.add(m_x[i]);
+		t_hash.add(m_y[i]);
+		t_hash.add(m_vx[i]);
+		t_hash.add(m_vy[i]);
+		t_hash.add(m_lifetime[i]);
+	}
+}
+
+////////////////////////////////////////////////////////////
+sf::Texture const * ProjectilePool::texture() const
+{
+	return m_texture;
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::render(std::vector<ShellSnapshot> const & t_shells, sf::Texture const * t_texture,
+	SpriteBatch & t_batch, Camera const & t_camera, float t_alpha)
+{
+	if (t_shells.empty())
+	{
+		return;
+	}
+
+	float halfWidth = s_PROJECTILE_RECT.width / 2.0f;
+	float halfHeight = s_PROJECTILE_RECT.height / 2.0f;
+	float left = static_cast<float>(s_PROJECTILE_RECT.left);
+	float top = static_cast<float>(s_PROJECTILE_RECT.top);
+	float right = left + s_PROJECTILE_RECT.width;
+	float bottom = top + s_PROJECTILE_RECT.height;
+
+	// A shell is visible if the circle around it, of radius half its length, overlaps the view.
+	sf::FloatRect visible = t_camera.visibleArea();
+	float minX = visible.left - halfWidth;
+	float maxX = visible.left + visible.width + halfWidth;
+	float minY = visible.top - halfWidth;
+	float maxY = visible.top + visible.height + halfWidth;
+
+	for (ShellSnapshot const & shell : t_shells)
+	{
+		float x = shell.m_previousX + (shell.m_x - shell.m_previousX) * t_alpha;
+		float y = shell.m_previousY + (shell.m_y - shell.m_previousY) * t_alpha;
+		if (x < minX || x > maxX || y < minY || y > maxY)
 		{
-			t_window.draw(m_projectiles.at(i).m_projectile);
+			continue;
 		}
+
+		// A shell always faces along its velocity, so the heading is the rotation.
+		sf::Vector2f along(shell.m_headingX * halfWidth, shell.m_headingY * halfWidth);
+		sf::Vector2f across(-shell.m_headingY * halfHeight, shell.m_headingX * halfHeight);
+		sf::Vector2f centre(x, y);
+
+		sf::Vertex quad[4] =
+		{
+			sf::Vertex(centre - along - across, sf::Color::Red, sf::Vector2f(left, top)),
+			sf::Vertex(centre + along - across, sf::Color::Red, sf::Vector2f(right, top)),
+			sf::Vertex(centre + along + across, sf::Color::Red, sf::Vector2f(right, bottom)),
+			sf::Vertex(centre - along + across, sf::Color::Red, sf::Vector2f(left, bottom))
+		};
+		t_batch.drawQuad(quad, t_texture);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::setWorldBounds(sf::FloatRect const & t_worldBounds)
+{
+	m_worldBounds = t_worldBounds;
+}
+
+////////////////////////////////////////////////////////////
+int ProjectilePool::capacity() const
+{
+	return static_cast<int>(m_index.size());
+}
+
+////////////////////////////////////////////////////////////
+int ProjectilePool::activeCount() const
+{
+	return m_activeCount;
+}
+
+////////////////////////////////////////////////////////////
+int ProjectilePool::activeSlot(int t_index) const
+{
+	return m_slot[t_index];
+}
+
+////////////////////////////////////////////////////////////
+bool ProjectilePool::isActive(int t_slot) const
+{
+	return m_index.at(t_slot) >= 0;
+}
+
+////////////////////////////////////////////////////////////
+sf::FloatRect ProjectilePool::bounds(int t_slot) const
+{
+	int index = m_index.at(t_slot);
+
+	// The bounding box of the shell rectangle rotated to its heading.
+	float cosine = std::abs(m_vx[index] / m_archetype.m_speed);
+	float sine = std::abs(m_vy[index] / m_archetype.m_speed);
+	float halfWidth = (cosine * s_PROJECTILE_RECT.width + sine * s_PROJECTILE_RECT.height) / 2.0f;
+	float halfHeight = (sine * s_PROJECTILE_RECT.width + cosine * s_PROJECTILE_RECT.height) / 2.0f;
+	return sf::FloatRect(m_x[index] - halfWidth, m_y[index] - halfHeight, 2 * halfWidth, 2 * halfHeight);
+}
+
+////////////////////////////////////////////////////////////
+sf::Vector2f ProjectilePool::position(int t_slot) const
+{
+	int index = m_index.at(t_slot);
+	return sf::Vector2f(m_x[index], m_y[index]);
+}
+
+////////////////////////////////////////////////////////////
+int ProjectilePool::damage() const
+{
+	return m_archetype.m_damage;
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::retire(int t_slot)
+{
+	removeAt(m_index.at(t_slot));
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::removeAt(int t_index)
+{
+	int slot = m_slot[t_index];
+	int last = --m_activeCount;
+	if (t_index != last)
+	{
+		m_x[t_index] = m_x[last];
+		m_y[t_index] = m_y[last];
+		m_newX[t_index] = m_newX[last];
+		m_newY[t_index] = m_newY[last];
+		m_previousX[t_index] = m_previousX[last];
+		m_previousY[t_index] = m_previousY[last];
+		m_vx[t_index] = m_vx[last];
+		m_vy[t_index] = m_vy[last];
+		m_lifetime[t_index] = m_lifetime[last];
+		m_slot[t_index] = m_slot[last];
+		m_index[m_slot[t_index]] = t_index;
 	}
-}
\ No newline at end of file
+
+	// Unlink the slot from the firing order.
+	int older = m_olderSlot[slot];
+	int newer = m_newerSlot[slot];
+	if (older >= 0)
+	{
+		m_newerSlot[older] = newer;
+	}
+	else
+	{
+		m_oldestSlot = newer;
+	}
+	if (newer >= 0)
+	{
+		m_olderSlot[newer] = older;
+	}
+	else
+	{
+		m_newestSlot = older;
+	}
+
+	m_index[slot] = -1;
+	m_nextFree[slot] = m_firstFree;
+	m_firstFree = slot;
+}
+
+////////////////////////////////////////////////////////////
+void ProjectilePool::setCapacity(int t_capacity)
+{
+	int oldCapacity = capacity();
+	for (std::vector<float> * array : { &m_x, &m_y, &m_newX, &m_newY, &m_previousX, &m_previousY, &m_vx, &m_vy, &m_lifetime })
+	{
+		array->resize(t_capacity);
+	}
+	m_slot.resize(t_capacity);
+	m_index.resize(t_capacity, -1);
+	m_nextFree.resize(t_capacity);
+	m_olderSlot.resize(t_capacity, -1);
+	m_newerSlot.resize(t_capacity, -1);
+
+	// Thread the new slots onto the free list, lowest slot first.
+	for (int slot = t_capacity - 1; slot >= oldCapacity; slot--)
+	{
+		m_nextFree[slot] = m_firstFree;
+		m_firstFree = slot;
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool ProjectilePool::isInWorld(float t_x, float t_y) const
+{
+	return t_x - s_PROJECTILE_RECT.width / 2 > m_worldBounds.left
+		&& t_x + s_PROJECTILE_RECT.width / 2 < m_worldBounds.left + m_worldBounds.width
+		&& t_y - s_PROJECTILE_RECT.height / 2 > m_worldBounds.top
+		&& t_y + s_PROJECTILE_RECT.height / 2 < m_worldBounds.top + m_worldBounds.height;
+}
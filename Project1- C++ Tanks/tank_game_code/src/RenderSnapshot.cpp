@@ -0,0 +1,44 @@
+#include "RenderSnapshot.h"
+#include "MathUtility.h"
+#include "DebugDraw.h"
+
+////////////////////////////////////////////////////////////
+void TankSnapshot::render(SpriteBatch & t_batch, Camera const & t_camera, float t_alpha) const
+{
+	sf::Sprite base = MathUtility::interpolate(m_base, m_previousBase, t_alpha);
+	sf::Sprite turret = MathUtility::interpolate(m_turret, m_previousTurret, t_alpha);
+	if (t_camera.isVisible(base.getGlobalBounds()) || t_camera.isVisible(turret.getGlobalBounds()))
+	{
+		t_batch.draw(base);
+		t_batch.draw(turret);
+	}
+}
+
+////////////////////////////////////////////////////////////
+sf::Vector2f TankSnapshot::position(float t_alpha) const
+{
+	return m_previousBase.getPosition() + (m_base.getPosition() - m_previousBase.getPosition()) * t_alpha;
+}
+
+////////////////////////////////////////////////////////////
+void SteeringSnapshot::renderDebug(Camera const & t_camera) const
+{
+	if (DebugDraw::isEnabled())
+	{
+		// The rays the steering casts, and the obstacles it avoids
+		DebugDraw::line(m_position, m_ahead, sf::Color::Red);
+		DebugDraw::line(m_position, m_aheadLeft, sf::Color::Green);
+		DebugDraw::line(m_position, m_aheadRight, sf::Color::Blue);
+
+		for (std::size_t i = 0; i < m_obstacles.size(); ++i)
+		{
+			ObstacleSnapshot const & obstacle = m_obstacles[i];
+			float radius = obstacle.m_radius;
+			if (t_camera.isVisible(sf::FloatRect(obstacle.m_centre.x - radius, obstacle.m_centre.y - radius, 2 * radius, 2 * radius)))
+			{
+				bool threat = static_cast<int>(i) == m_mostThreatening;
+				DebugDraw::circle(obstacle.m_centre, radius, threat ? sf::Color::Red : sf::Color(255, 255, 255, 63));
+			}
+		}
+	}
+}
@@ -0,0 +1,70 @@
+#include "SpriteBatch.h"
+
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch(sf::RenderTarget & t_target)
+	: m_target(t_target)
+{
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(sf::Sprite const & t_sprite, sf::BlendMode const & t_blendMode)
+{
+	sf::Transform const & transform = t_sprite.getTransform();
+	sf::FloatRect local = t_sprite.getLocalBounds();
+	sf::IntRect rect = t_sprite.getTextureRect();
+	sf::Color colour = t_sprite.getColor();
+
+	// A negative width or height in the texture rect flips the sprite, which falls out of this naturally.
+	float left = static_cast<float>(rect.left);
+	float top = static_cast<float>(rect.top);
+	float right = left + rect.width;
+	float bottom = top + rect.height;
+
+	sf::Vertex quad[4] =
+	{
+		sf::Vertex(transform.transformPoint(0.0f, 0.0f), colour, sf::Vector2f(left, top)),
+		sf::Vertex(transform.transformPoint(local.width, 0.0f), colour, sf::Vector2f(right, top)),
+		sf::Vertex(transform.transformPoint(local.width, local.height), colour, sf::Vector2f(right, bottom)),
+		sf::Vertex(transform.transformPoint(0.0f, local.height), colour, sf::Vector2f(left, bottom))
+	};
+	drawQuad(quad, t_sprite.getTexture(), t_blendMode);
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::drawQuad(sf::Vertex const * t_quad, sf::Texture const * t_texture, sf::BlendMode const & t_blendMode)
+{
+	if (!m_vertices.empty() && (t_texture != m_texture || t_blendMode != m_blendMode))
+	{
+		flush();
+	}
+	m_texture = t_texture;
+	m_blendMode = t_blendMode;
+
+	m_vertices.push_back(t_quad[0]);
+	m_vertices.push_back(t_quad[1]);
+	m_vertices.push_back(t_quad[2]);
+	m_vertices.push_back(t_quad[0]);
+	m_vertices.push_back(t_quad[2]);
+	m_vertices.push_back(t_quad[3]);
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(sf::Drawable const & t_drawable, sf::RenderStates const & t_states)
+{
+	flush();
+	m_target.draw(t_drawable, t_states);
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::flush()
+{
+	if (m_vertices.empty())
+	{
+		return;
+	}
+
+	sf::RenderStates states(m_blendMode);
+	states.texture = m_texture;
+	m_target.draw(m_vertices.data(), m_vertices.size(), sf::Triangles, states);
+	m_vertices.clear();
+}
@@ -0,0 +1,111 @@
+#include "SweepAndPrune.h"
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+int SweepAndPrune::createProxy(sf::FloatRect const & t_bounds, int t_group, int t_kind, int t_index)
+{
+	int id;
+	if (m_freeProxies.empty())
+	{
+		id = static_cast<int>(m_proxies.size());
+		m_proxies.push_back(Proxy());
+	}
+	else
+	{
+		id = m_freeProxies.back();
+		m_freeProxies.pop_back();
+	}
+	m_proxies[id] = Proxy{ t_bounds, t_group, t_kind, t_index };
+
+	// Appended at the end; the next update() sorts it into place.
+	m_sorted.push_back(Endpoint{ t_bounds.left, id });
+	return id;
+}
+
+////////////////////////////////////////////////////////////
+void SweepAndPrune::destroyProxy(int t_proxy)
+{
+	m_freeProxies.push_back(t_proxy);
+
+	// Erasing keeps the remaining endpoints in order.
+	m_sorted.erase(std::find_if(m_sorted.begin(), m_sorted.end(),
+		[t_proxy](Endpoint const & t_endpoint) { return t_endpoint.m_proxy == t_proxy; }));
+}
+
+////////////////////////////////////////////////////////////
+void SweepAndPrune::setBounds(int t_proxy, sf::FloatRect const & t_bounds)
+{
+	m_proxies[t_proxy].m_bounds = t_bounds;
+}
+
+////////////////////////////////////////////////////////////
+void SweepAndPrune::update()
+{
+	for (Endpoint & endpoint : m_sorted)
+	{
+		endpoint.m_min = m_proxies[endpoint.m_proxy].m_bounds.left;
+	}
+
+	// Insertion sort: the list was sorted last tick and objects only move a little,
+	//  so almost every element is already in place and this is close to O(n).
+	for (std::size_t i = 1; i < m_sorted.size(); ++i)
+	{
+		Endpoint endpoint = m_sorted[i];
+		std::size_t j = i;
+		while (j > 0 && m_sorted[j - 1].m_min > endpoint.m_min)
+		{
+			m_sorted[j] = m_sorted[j - 1];
+			--j;
+		}
+		m_sorted[j] = endpoint;
+	}
+
+	// Sweep: each proxy can only overlap those that start before it ends along x.
+	// Overlap is strict, as in sf::FloatRect::intersects().
+	m_pairs.clear();
+	for (std::size_t i = 0; i < m_sorted.size(); ++i)
+	{
+		Proxy const & a = m_proxies[m_sorted[i].m_proxy];
+		float right = a.m_bounds.left + a.m_bounds.width;
+
+		for (std::size_t j = i + 1; j < m_sorted.size() && m_sorted[j].m_min < right; ++j)
+		{
+			Proxy const & b = m_proxies[m_sorted[j].m_proxy];
+			if (a.m_group == b.m_group)
+			{
+				continue;
+			}
+			if (a.m_bounds.top >= b.m_bounds.top + b.m_bounds.height || b.m_bounds.top >= a.m_bounds.top + a.m_bounds.height)
+			{
+				continue;
+			}
+
+			if (a.m_kind <= b.m_kind)
+			{
+				m_pairs.push_back(Pair{ m_sorted[i].m_proxy, m_sorted[j].m_proxy });
+			}
+			else
+			{
+				m_pairs.push_back(Pair{ m_sorted[j].m_proxy, m_sorted[i].m_proxy });
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+std::vector<SweepAndPrune::Pair> const & SweepAndPrune::pairs() const
+{
+	return m_pairs;
+}
+
+////////////////////////////////////////////////////////////
+int SweepAndPrune::kind(int t_proxy) const
+{
+	return m_proxies[t_proxy].m_kind;
+}
+
+////////////////////////////////////////////////////////////
+int SweepAndPrune::index(int t_proxy) const
+{
+	return m_proxies[t_proxy].m_index;
+}
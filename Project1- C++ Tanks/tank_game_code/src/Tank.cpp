@@ -5,14 +5,15 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-Tank::Tank(thor::ResourceHolder<sf::Texture, std::string> & t_holder, std::vector<sf::Sprite>& t_wallSprites)
-: m_holder(t_holder), m_wallSprites(t_wallSprites)
+Tank::Tank(sf::Texture const * t_texture, std::vector<sf::Sprite>& t_wallSprites, WallGrid const & t_wallGrid)
+: m_texture(t_texture), m_wallSprites(t_wallSprites), m_wallGrid(t_wallGrid)
 {
 	initSprites();
 }
 
-void Tank::update(double dt, sf::Sprite t_base, std::function<void(int)> t_funcApplyDamage)
+void Tank::update(double dt, TankInput const & t_input)
 {	
+	PROFILE_SCOPE(ProfileZone::TANK_UPDATE);
 	// This function call is checking for collisions between the tank and walls
 	// Changes the tanks state to colliding if collision is present, normal if no collision
 	if (checkWallCollision())
@@ -31,7 +32,7 @@ void Tank::update(double dt, sf::Sprite t_base, std::function<void(int)> t_funcA
 			break;
 	case TankState::NORMAL:
 			//This function now handles input, it allows for rotation and speed to be manipulated simultaneously
-			handleKeyInput();
+			handleInput(t_input, dt);
 			m_speed = std::clamp(m_speed, MAX_REVERSE_SPEED, MAX_FORWARD_SPEED);
 			float radians = m_rotation * (M_PI / 180.0f);
 			float newXposition = m_tankBase.getPosition().x + std::cos(radians) * m_speed * (dt / 1000);
@@ -44,24 +45,17 @@ void Tank::update(double dt, sf::Sprite t_base, std::function<void(int)> t_funcA
 				m_shootTimer -= dt;
 				if (m_shootTimer <= 0) {
 					requestFire();
-					m_shootTimer = s_TIME_BETWEEN_SHOTS;
+					m_shootTimer = m_reloadTime;
 					m_fireRequested = false;
 				}
 			}
 
 			// Update the projectile pool
-			m_Pool.update(dt, m_wallSprites, t_base, t_funcApplyDamage);
+			m_Pool.update(dt, m_wallGrid);
 			//m_turretRotation = m_rotation;
 			m_turret.setRotation(m_turretRotation);
 
-			if (m_speed > 0)
-			{
-				m_speed *= FRICTION;
-			}
-			if (m_speed < 0)
-			{
-				m_speed *= FRICTION;
-			}
+			m_speed *= std::pow(FRICTION, dt / FRICTION_STEP_MS);
 
 			if (m_turretRotation > 180)
 			{
@@ -77,17 +71,43 @@ void Tank::update(double dt, sf::Sprite t_base, std::function<void(int)> t_funcA
 	}
 }
 
-void Tank::render(sf::RenderWindow & window) 
+void Tank::storePreviousState()
+{
+	m_previousBase = m_tankBase;
+	m_previousTurret = m_turret;
+	m_Pool.storePreviousState();
+}
+
+void Tank::snapshot(TankSnapshot & t_snapshot) const
 {
-	window.draw(m_tankBase);
-	window.draw(m_turret);
-	m_Pool.render(window);
+	t_snapshot.m_base = m_tankBase;
+	t_snapshot.m_turret = m_turret;
+	t_snapshot.m_previousBase = m_previousBase;
+	t_snapshot.m_previousTurret = m_previousTurret;
+}
+
+void Tank::hash(StateHash & t_hash) const
+{
+	t_hash.add(m_tankBase.getPosition());
+	t_hash.add(m_tankBase.getRotation());
+	t_hash.add(m_turret.getPosition());
+	t_hash.add(m_turret.getRotation());
+	t_hash.add(m_speed);
+	t_hash.add(m_rotation);
+	t_hash.add(m_turretRotation);
+	t_hash.add(direction);
+	t_hash.add(static_cast<int>(m_state));
+	t_hash.add(m_fireRequested);
+	t_hash.add(m_shootTimer);
+	m_Pool.hash(t_hash);
 }
 
 void Tank::setPosition(sf::Vector2f t_position)
 {
 	m_tankBase.setPosition(t_position);
 	m_turret.setPosition(t_position);
+	// A teleport, so don't draw the tank sliding over from where it was
+	storePreviousState();
 }
 
 sf::Vector2f Tank::getPosition() const
@@ -128,104 +148,114 @@ const sf::Sprite& Tank::getBase() const
 	// TODO: insert return statement here
 }
 
+ProjectilePool& Tank::getProjectiles()
+{
+	return m_Pool;
+}
 
-void Tank::increaseSpeed()
+const ProjectilePool& Tank::getProjectiles() const
 {
-	m_speed += 1;
+	return m_Pool;
 }
 
-void Tank::decreaseSpeed()
+
+void Tank::increaseSpeed(double dt)
 {
-	m_speed -= 1;
+	m_speed += ACCELERATION * (dt / 1000);
 }
 
-void Tank::increaseRotation()
+void Tank::decreaseSpeed(double dt)
 {
-	m_rotation += 1;
-	m_turretRotation += 1;
-	if (m_rotation == 360.0)
+	m_speed -= ACCELERATION * (dt / 1000);
+}
+
+void Tank::increaseRotation(double dt)
+{
+	double step = ROTATION_SPEED * (dt / 1000);
+	m_rotation += step;
+	m_turretRotation += step;
+	if (m_rotation >= 360.0)
 	{
-		m_rotation = 0;
+		m_rotation -= 360.0;
 	}
 }
 
 
-void Tank::decreaseRotation()
+void Tank::decreaseRotation(double dt)
 {
-	m_rotation -= 1;
-	m_turretRotation -= 1;
-	if (m_rotation == 0.0)
+	double step = ROTATION_SPEED * (dt / 1000);
+	m_rotation -= step;
+	m_turretRotation -= step;
+	if (m_rotation < 0.0)
 	{
-		m_rotation = 359.0;
+		m_rotation += 360.0;
 	}
 }
 
-void Tank::handleKeyInput()
+void Tank::handleInput(TankInput const & t_input, double dt)
 {
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))
+	if (t_input.isDown(TankInput::ACCELERATE))
 	{
-		increaseSpeed();
-		//std::cout << "Increasing speed!\n";
+		increaseSpeed(dt);
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down))
+	if (t_input.isDown(TankInput::BRAKE))
 	{
-		decreaseSpeed();
-		//std::cout << "Decreasing speed!\n";
+		decreaseSpeed(dt);
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left))
+	if (t_input.isDown(TankInput::TURN_LEFT))
 	{
-		decreaseRotation();
-		//std::cout << "Decreasing rotation!\n";
+		decreaseRotation(dt);
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right))
+	if (t_input.isDown(TankInput::TURN_RIGHT))
 	{
-		increaseRotation();
-		//std::cout << "Increasing rotation!\n";
+		increaseRotation(dt);
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::X))
+	if (t_input.isDown(TankInput::TURRET_RIGHT))
 	{
-		increaseTurretRotation();
+		increaseTurretRotation(dt);
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Z))
+	if (t_input.isDown(TankInput::TURRET_LEFT))
 	{
-		decreaseTurretRotation();
+		decreaseTurretRotation(dt);
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::C))
+	if (t_input.isDown(TankInput::CENTRE_TURRET))
 	{
-		centreTurret();
+		centreTurret(dt);
 	}
-	if (sf::Keyboard::isKeyPressed((sf::Keyboard::Space))) {
+	if (t_input.isDown(TankInput::FIRE)) {
 		m_fireRequested = true;
 	}
 }
 
-void Tank::increaseTurretRotation()
+void Tank::increaseTurretRotation(double dt)
 {
-	m_turretRotation += 1;
+	m_turretRotation += TURRET_ROTATION_SPEED * (dt / 1000);
 	//std::cout << "Increasing turret rotaion!\n";
 	m_turret.setRotation(m_turretRotation);
 
 	if (m_turretRotation >= 360)
 	{
-		m_turretRotation = 0;
+		m_turretRotation -= 360;
 	}
 	
 }
 
-void Tank::decreaseTurretRotation()
+void Tank::decreaseTurretRotation(double dt)
 {
-	m_turretRotation -= 1;
+	m_turretRotation -= TURRET_ROTATION_SPEED * (dt / 1000);
 	//std::cout << "Decreasing turret rotaion!\n";
 	m_turret.setRotation(m_turretRotation);
 
-	if (m_turretRotation <= 0)
+	if (m_turretRotation < 0)
 	{
-		m_turretRotation = 359;
+		m_turretRotation += 360;
 	}
 }
 
-bool Tank::centreTurret()
+bool Tank::centreTurret(double dt)
 {
+	double step = m_recentreTurretSpeed * (dt / 1000);
+
 	// Calculate the difference between the turret's rotation and the tank's base rotation
 	float rotationDifference = m_turretRotation - m_rotation;
 
@@ -234,7 +264,7 @@ bool Tank::centreTurret()
 	while (rotationDifference < -180) rotationDifference += 360;
 
 	// If the turret is already aligned with the tank, return false
-	if (std::abs(rotationDifference) < 1.0f) // If the turret is more or less exactly centered 
+	if (std::abs(rotationDifference) <= step) // If the turret is within one step of centered 
 	{
 		m_turretRotation = m_rotation; // Ensure the turret is exactly aligned
 		m_turret.setRotation(m_turretRotation);
@@ -245,13 +275,13 @@ bool Tank::centreTurret()
 	if (rotationDifference > 0)
 	{
 		// Rotate counterclockwise
-		m_turretRotation -= m_recentreTurretSpeed;
+		m_turretRotation -= step;
 		if (m_turretRotation < 0) m_turretRotation += 360; // Wrap around if necessary
 	}
 	else
 	{
 		// Rotate clockwise
-		m_turretRotation += m_recentreTurretSpeed;
+		m_turretRotation += step;
 		if (m_turretRotation >= 360) m_turretRotation -= 360; // Wrap around if necessary
 	}
 
@@ -264,29 +294,54 @@ bool Tank::centreTurret()
 
 bool Tank::checkWallCollision()
 {
-	for (sf::Sprite const& sprite : m_wallSprites)
+	PROFILE_SCOPE(ProfileZone::WALL_COLLISION);
+	// Only walls in the cells covered by the base or the turret can be hit.
+	sf::FloatRect baseBounds = m_tankBase.getGlobalBounds();
+	sf::FloatRect turretBounds = m_turret.getGlobalBounds();
+	float left = std::min(baseBounds.left, turretBounds.left);
+	float top = std::min(baseBounds.top, turretBounds.top);
+	sf::FloatRect bounds(left, top,
+		std::max(baseBounds.left + baseBounds.width, turretBounds.left + turretBounds.width) - left,
+		std::max(baseBounds.top + baseBounds.height, turretBounds.top + turretBounds.height) - top);
+
+	OrientedBoundingBox turretBox(m_turret);
+	OrientedBoundingBox baseBox(m_tankBase);
+
+	// The walls of each row of cells are stored contiguously, so SAT test the turret and
+	// the base against a whole row of walls at once, then act on the results in order.
+	return m_wallGrid.forEachSpanInCells(m_wallGrid.cellRange(bounds), [&](int t_first, int t_last)
 	{
-		// Checks if either the tank base or turret has collided
-		// with the current wall sprite.
-		// Intiially looks odd due to collision between the white space of the turret sprtie and the walls
-		if (CollisionDetector::collision(m_turret, sprite))
+		m_turretHits.resize(t_last - t_first);
+		m_baseHits.resize(t_last - t_first);
+		CollisionDetector::collideBatch(turretBox, m_wallGrid.batch(), t_first, t_last, m_turretHits.data());
+		CollisionDetector::collideBatch(baseBox, m_wallGrid.batch(), t_first, t_last, m_baseHits.data());
+
+		for (int slot = t_first; slot < t_last; ++slot)
 		{
-			// Now perform a pixel perfect collision test...
-			if (CollisionDetector::pixelPerfectTest(m_turret, sprite))
+			sf::Sprite const& sprite = m_wallSprites[m_wallGrid.wallAt(slot)];
+
+			// Checks if either the tank base or turret has collided
+			// with the current wall sprite.
+			// Intiially looks odd due to collision between the white space of the turret sprtie and the walls
+			if (m_turretHits[slot - t_first])
 			{
-				// Get contact normal vector
-				m_contactNormal = m_turret.getPosition() - sprite.getPosition();
+				// Now perform a pixel perfect collision test...
+				if (CollisionDetector::pixelPerfectTest(m_turret, sprite))
+				{
+					// Get contact normal vector
+					m_contactNormal = m_turret.getPosition() - sprite.getPosition();
+					return true;
+				}
+			}
+			else if (m_baseHits[slot - t_first])
+			{
+				// Get contact normal vector between tank base and the wall
+				m_contactNormal = m_tankBase.getPosition() - sprite.getPosition();
 				return true;
 			}
 		}
-		else if (CollisionDetector::collision(m_tankBase, sprite))
-		{
-			// Get contact normal vector between tank base and the wall
-			m_contactNormal = m_tankBase.getPosition() - sprite.getPosition();
-			return true;
-		}
-	}
-	return false;
+		return false;
+	});
 }
 
 void Tank::deflect(double dt)
@@ -316,13 +371,11 @@ void Tank::requestFire() {
 	double turretRotation = m_turret.getRotation();
 
 	// Request a projectile from the pool
-	m_Pool.create(m_holder["tankAtlas"], turretTipX, turretTipY, turretRotation);
+	m_Pool.create(m_texture, turretTipX, turretTipY, turretRotation);
 }
 
 void Tank::initSprites()
 {
-	m_holder.acquire("tankAtlas", thor::Resources::fromFile<sf::Texture>("resources/images/spritesheet.png"));
-	sf::Texture& texture = m_holder["tankAtlas"];
 	int currentLevel = 1;
 
 	// Will generate an exception if level loading fails
@@ -337,8 +390,17 @@ void Tank::initSprites()
 		throw e;
 	}
 
+	// Size the pool to the most shells this tank can actually have in flight
+	WeaponData const & weapon = m_level.m_tank.m_weapon;
+	m_Pool = ProjectilePool(weapon.m_maxProjectiles, weapon.m_projectile);
+	m_reloadTime = weapon.m_reloadTime;
 
-	m_tankBase.setTexture(texture);
+	// Headless sprites have no texture; their texture rects still give them their size.
+	if (m_texture != nullptr)
+	{
+		m_tankBase.setTexture(*m_texture);
+		m_turret.setTexture(*m_texture);
+	}
 	m_tankBase.setTextureRect(sf::IntRect(481, 1501, 246, 114));
 	//Set the tanks position using the YAML data
 	m_tankBase.setPosition(m_level.m_tank.m_position.x, m_level.m_tank.m_position.y);
@@ -348,9 +410,9 @@ void Tank::initSprites()
 	m_tankBase.setScale(m_level.m_tank.m_scale, m_level.m_tank.m_scale);
 	m_tankBase.setRotation(0);
 
-	m_turret.setTexture(texture);
 	m_turret.setTextureRect(sf::IntRect(481, 1730, 210, 94));
 	m_turret.setOrigin(90, m_turret.getGlobalBounds().height / 2);
 	m_turret.setScale(m_level.m_tank.m_scale, m_level.m_tank.m_scale);
 	m_turret.setPosition(m_tankBase.getOrigin());
+	storePreviousState();
 }
\ No newline at end of file
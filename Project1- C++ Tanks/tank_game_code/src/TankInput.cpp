@@ -0,0 +1,52 @@
+#include "TankInput.h"
+#include <SFML/Window/Keyboard.hpp>
+#include <cstring>
+
+namespace
+{
+	struct Binding
+	{
+		TankInput::Control m_control;
+		sf::Keyboard::Key m_key;
+		char const * m_name;
+	};
+
+	Binding const s_BINDINGS[] =
+	{
+		{ TankInput::ACCELERATE, sf::Keyboard::Up, "ACCELERATE" },
+		{ TankInput::BRAKE, sf::Keyboard::Down, "BRAKE" },
+		{ TankInput::TURN_LEFT, sf::Keyboard::Left, "TURN_LEFT" },
+		{ TankInput::TURN_RIGHT, sf::Keyboard::Right, "TURN_RIGHT" },
+		{ TankInput::TURRET_LEFT, sf::Keyboard::Z, "TURRET_LEFT" },
+		{ TankInput::TURRET_RIGHT, sf::Keyboard::X, "TURRET_RIGHT" },
+		{ TankInput::CENTRE_TURRET, sf::Keyboard::C, "CENTRE_TURRET" },
+		{ TankInput::FIRE, sf::Keyboard::Space, "FIRE" }
+	};
+}
+
+////////////////////////////////////////////////////////////
+TankInput TankInput::fromKeyboard()
+{
+	TankInput input;
+	for (Binding const & binding : s_BINDINGS)
+	{
+		if (sf::Keyboard::isKeyPressed(binding.m_key))
+		{
+			input.press(binding.m_control);
+		}
+	}
+	return input;
+}
+
+////////////////////////////////////////////////////////////
+std::uint8_t TankInput::controlNamed(char const * t_name)
+{
+	for (Binding const & binding : s_BINDINGS)
+	{
+		if (std::strcmp(binding.m_name, t_name) == 0)
+		{
+			return binding.m_control;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,130 @@
+#include "WallGrid.h"
+#include <algorithm>
+#include <cmath>
+
+////////////////////////////////////////////////////////////
+WallGrid::WallGrid(float t_cellSize)
+	: m_cellSize(t_cellSize)
+{
+}
+
+////////////////////////////////////////////////////////////
+void WallGrid::build(std::vector<sf::Sprite> const & t_wallSprites)
+{
+	m_columns = 0;
+	m_rows = 0;
+	m_maxHalfExtent = 0.0f;
+	m_cellStart.clear();
+	m_walls.clear();
+	m_colliders.clear();
+	m_batch.Clear();
+
+	if (t_wallSprites.empty())
+	{
+		return;
+	}
+
+	// Find the extent of the wall centres and the largest wall.
+	sf::Vector2f minCentre = t_wallSprites.front().getPosition();
+	sf::Vector2f maxCentre = minCentre;
+	m_colliders.reserve(t_wallSprites.size());
+	for (sf::Sprite const & wall : t_wallSprites)
+	{
+		m_colliders.emplace_back(wall);
+
+		sf::Vector2f centre = wall.getPosition();
+		minCentre.x = std::min(minCentre.x, centre.x);
+		minCentre.y = std::min(minCentre.y, centre.y);
+		maxCentre.x = std::max(maxCentre.x, centre.x);
+		maxCentre.y = std::max(maxCentre.y, centre.y);
+
+		// The position is the origin, which is not necessarily the middle of the bounds,
+		//  so measure the furthest bounding box edge from it.
+		sf::FloatRect bounds = wall.getGlobalBounds();
+		float halfExtent = std::max({ centre.x - bounds.left, bounds.left + bounds.width - centre.x,
+			centre.y - bounds.top, bounds.top + bounds.height - centre.y });
+		m_maxHalfExtent = std::max(m_maxHalfExtent, halfExtent);
+	}
+
+	m_origin = minCentre;
+	m_columns = static_cast<int>((maxCentre.x - minCentre.x) / m_cellSize) + 1;
+	m_rows = static_cast<int>((maxCentre.y - minCentre.y) / m_cellSize) + 1;
+
+	// Counting sort of the walls by cell: count, prefix sum, then scatter.
+	std::vector<int> wallCell(t_wallSprites.size());
+	m_cellStart.assign(m_columns * m_rows + 1, 0);
+	for (std::size_t i = 0; i < t_wallSprites.size(); ++i)
+	{
+		sf::Vector2f centre = t_wallSprites[i].getPosition();
+		int column = static_cast<int>((centre.x - m_origin.x) / m_cellSize);
+		int row = static_cast<int>((centre.y - m_origin.y) / m_cellSize);
+		wallCell[i] = row * m_columns + column;
+		m_cellStart[wallCell[i] + 1]++;
+	}
+	for (std::size_t cell = 1; cell < m_cellStart.size(); ++cell)
+	{
+		m_cellStart[cell] += m_cellStart[cell - 1];
+	}
+
+	m_walls.resize(t_wallSprites.size());
+	std::vector<int> insertAt(m_cellStart.begin(), m_cellStart.end() - 1);
+	for (std::size_t i = 0; i < t_wallSprites.size(); ++i)
+	{
+		m_walls[insertAt[wallCell[i]]++] = static_cast<int>(i);
+	}
+
+	for (int wall : m_walls)
+	{
+		m_batch.Add(m_colliders[wall]);
+	}
+}
+
+////////////////////////////////////////////////////////////
+sf::IntRect WallGrid::cellRange(sf::FloatRect const & t_bounds) const
+{
+	if (m_walls.empty())
+	{
+		return sf::IntRect(0, 0, 0, 0);
+	}
+
+	// Any wall whose centre lies within the widened bounds may overlap the original bounds.
+	float left = (t_bounds.left - m_maxHalfExtent - m_origin.x) / m_cellSize;
+	float top = (t_bounds.top - m_maxHalfExtent - m_origin.y) / m_cellSize;
+	float right = (t_bounds.left + t_bounds.width + m_maxHalfExtent - m_origin.x) / m_cellSize;
+	float bottom = (t_bounds.top + t_bounds.height + m_maxHalfExtent - m_origin.y) / m_cellSize;
+
+	int firstColumn = std::max(0, static_cast<int>(std::floor(left)));
+	int firstRow = std::max(0, static_cast<int>(std::floor(top)));
+	int lastColumn = std::min(m_columns - 1, static_cast<int>(std::floor(right)));
+	int lastRow = std::min(m_rows - 1, static_cast<int>(std::floor(bottom)));
+
+	if (firstColumn > lastColumn || firstRow > lastRow)
+	{
+		return sf::IntRect(0, 0, 0, 0);
+	}
+	return sf::IntRect(firstColumn, firstRow, lastColumn - firstColumn + 1, lastRow - firstRow + 1);
+}
+
+////////////////////////////////////////////////////////////
+int WallGrid::wallCount() const
+{
+	return static_cast<int>(m_walls.size());
+}
+
+////////////////////////////////////////////////////////////
+StaticCollider const & WallGrid::collider(int t_wall) const
+{
+	return m_colliders[t_wall];
+}
+
+////////////////////////////////////////////////////////////
+int WallGrid::wallAt(int t_slot) const
+{
+	return m_walls[t_slot];
+}
+
+////////////////////////////////////////////////////////////
+ObbBatch const & WallGrid::batch() const
+{
+	return m_batch;
+}
@@ -0,0 +1,173 @@
+#include "WallLayer.h"
+#include <algorithm>
+
+namespace
+{
+	////////////////////////////////////////////////////////////
+	sf::FloatRect merge(sf::FloatRect const & t_first, sf::FloatRect const & t_second)
+	{
+		float left = std::min(t_first.left, t_second.left);
+		float top = std::min(t_first.top, t_second.top);
+		float right = std::max(t_first.left + t_first.width, t_second.left + t_second.width);
+		float bottom = std::max(t_first.top + t_first.height, t_second.top + t_second.height);
+		return sf::FloatRect(left, top, right - left, bottom - top);
+	}
+}
+
+////////////////////////////////////////////////////////////
+WallLayer::WallLayer(float t_chunkSize)
+	: m_chunkSize(t_chunkSize)
+{
+}
+
+////////////////////////////////////////////////////////////
+void WallLayer::build(std::vector<sf::Sprite> const & t_wallSprites)
+{
+	m_wallSprites = &t_wallSprites;
+	m_texture = nullptr;
+	m_columns = 0;
+	m_rows = 0;
+	m_chunks.clear();
+	m_wallChunk.clear();
+
+	if (t_wallSprites.empty())
+	{
+		return;
+	}
+	m_texture = t_wallSprites.front().getTexture();
+
+	sf::Vector2f minCentre = t_wallSprites.front().getPosition();
+	sf::Vector2f maxCentre = minCentre;
+	for (sf::Sprite const & wall : t_wallSprites)
+	{
+		sf::Vector2f centre = wall.getPosition();
+		minCentre.x = std::min(minCentre.x, centre.x);
+		minCentre.y = std::min(minCentre.y, centre.y);
+		maxCentre.x = std::max(maxCentre.x, centre.x);
+		maxCentre.y = std::max(maxCentre.y, centre.y);
+	}
+
+	m_origin = minCentre;
+	m_columns = static_cast<int>((maxCentre.x - minCentre.x) / m_chunkSize) + 1;
+	m_rows = static_cast<int>((maxCentre.y - minCentre.y) / m_chunkSize) + 1;
+	m_chunks.resize(m_columns * m_rows);
+
+	m_wallChunk.resize(t_wallSprites.size());
+	for (std::size_t i = 0; i < t_wallSprites.size(); ++i)
+	{
+		int chunk = chunkAt(t_wallSprites[i].getPosition());
+		m_wallChunk[i] = chunk;
+		m_chunks[chunk].m_walls.push_back(static_cast<int>(i));
+	}
+}
+
+////////////////////////////////////////////////////////////
+void WallLayer::wallChanged(int t_wall)
+{
+	int oldChunk = m_wallChunk.at(t_wall);
+	int newChunk = chunkAt((*m_wallSprites)[t_wall].getPosition());
+	m_chunks[oldChunk].m_dirty = true;
+
+	if (newChunk != oldChunk)
+	{
+		std::vector<int> & walls = m_chunks[oldChunk].m_walls;
+		walls.erase(std::find(walls.begin(), walls.end(), t_wall));
+		m_chunks[newChunk].m_walls.push_back(t_wall);
+		m_chunks[newChunk].m_dirty = true;
+		m_wallChunk[t_wall] = newChunk;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void WallLayer::render(sf::RenderTarget & t_target)
+{
+	m_drawCalls = 0;
+
+	sf::View const & view = t_target.getView();
+	sf::FloatRect visible(view.getCenter() - view.getSize() / 2.0f, view.getSize());
+	sf::RenderStates states(m_texture);
+
+	for (Chunk & chunk : m_chunks)
+	{
+		if (chunk.m_dirty)
+		{
+			rebuild(chunk);
+		}
+		if (chunk.m_vertices.empty() || !chunk.m_bounds.intersects(visible))
+		{
+			continue;
+		}
+
+		if (chunk.m_buffer.getVertexCount() > 0)
+		{
+			t_target.draw(chunk.m_buffer, states);
+		}
+		else
+		{
+			t_target.draw(chunk.m_vertices.data(), chunk.m_vertices.size(), sf::Triangles, states);
+		}
+		m_drawCalls++;
+	}
+}
+
+////////////////////////////////////////////////////////////
+int WallLayer::drawCalls() const
+{
+	return m_drawCalls;
+}
+
+////////////////////////////////////////////////////////////
+int WallLayer::chunkAt(sf::Vector2f t_position) const
+{
+	int column = std::clamp(static_cast<int>((t_position.x - m_origin.x) / m_chunkSize), 0, m_columns - 1);
+	int row = std::clamp(static_cast<int>((t_position.y - m_origin.y) / m_chunkSize), 0, m_rows - 1);
+	return row * m_columns + column;
+}
+
+////////////////////////////////////////////////////////////
+void WallLayer::rebuild(Chunk & t_chunk)
+{
+	t_chunk.m_dirty = false;
+	t_chunk.m_vertices.clear();
+	t_chunk.m_bounds = sf::FloatRect();
+
+	for (std::size_t i = 0; i < t_chunk.m_walls.size(); ++i)
+	{
+		sf::Sprite const & wall = (*m_wallSprites)[t_chunk.m_walls[i]];
+		sf::Transform const & transform = wall.getTransform();
+		sf::FloatRect local = wall.getLocalBounds();
+		sf::IntRect rect = wall.getTextureRect();
+		sf::Color colour = wall.getColor();
+
+		float left = static_cast<float>(rect.left);
+		float top = static_cast<float>(rect.top);
+		float right = left + rect.width;
+		float bottom = top + rect.height;
+
+		sf::Vertex topLeft(transform.transformPoint(0.0f, 0.0f), colour, sf::Vector2f(left, top));
+		sf::Vertex topRight(transform.transformPoint(local.width, 0.0f), colour, sf::Vector2f(right, top));
+		sf::Vertex bottomRight(transform.transformPoint(local.width, local.height), colour, sf::Vector2f(right, bottom));
+		sf::Vertex bottomLeft(transform.transformPoint(0.0f, local.height), colour, sf::Vector2f(left, bottom));
+
+		t_chunk.m_vertices.push_back(topLeft);
+		t_chunk.m_vertices.push_back(topRight);
+		t_chunk.m_vertices.push_back(bottomRight);
+		t_chunk.m_vertices.push_back(topLeft);
+		t_chunk.m_vertices.push_back(bottomRight);
+		t_chunk.m_vertices.push_back(bottomLeft);
+
+		sf::FloatRect bounds = wall.getGlobalBounds();
+		t_chunk.m_bounds = i == 0 ? bounds : merge(t_chunk.m_bounds, bounds);
+	}
+
+	// Without vertex buffer support the chunk is drawn straight from m_vertices.
+	if (t_chunk.m_vertices.empty() || !sf::VertexBuffer::isAvailable())
+	{
+		return;
+	}
+	if (t_chunk.m_buffer.getVertexCount() != t_chunk.m_vertices.size())
+	{
+		t_chunk.m_buffer.create(t_chunk.m_vertices.size());
+	}
+	t_chunk.m_buffer.update(t_chunk.m_vertices.data());
+}
@@ -0,0 +1,263 @@
+#include "World.h"
+#include "Logger.h"
+#include <iostream>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////
+World::World(sf::Texture const * t_atlas)
+	: m_atlas(t_atlas),
+	m_tank(t_atlas, m_wallSprites, m_wallGrid),
+	m_aiTank(t_atlas, m_wallSprites)
+{
+	int currentLevel = 1;
+
+	// Will generate an exception if level loading fails
+	try
+	{
+		LevelLoader::load(currentLevel, m_level);
+	}
+	catch (std::exception& e)
+	{
+		std::cout << "Level Loading failure." << std::endl;
+		std::cout << e.what() << std::endl;
+		throw;
+	}
+	generateWalls();
+
+	m_aiTank.init(m_level.m_aiTank.m_position, m_level.m_aiTank.m_scale);
+	initBroadphase();
+	m_tank.getProjectiles().setWorldBounds(m_bounds);
+}
+
+////////////////////////////////////////////////////////////
+sf::Texture const * World::loadAtlas(thor::ResourceHolder<sf::Texture, std::string> * t_holder)
+{
+	// Load the image once and create the texture from it, so the collision masks can be baked
+	//  from the same pixels without reading the texture back from the GPU later.
+	const std::string atlasFile = "resources/images/spritesheet.png";
+	sf::Image atlasImage;
+	if (!atlasImage.loadFromFile(atlasFile))
+	{
+		std::string errorMsg("Error loading " + atlasFile);
+		throw std::runtime_error(errorMsg);
+	}
+
+	sf::Texture const * texture = nullptr;
+	if (t_holder != nullptr)
+	{
+		t_holder->acquire("tankAtlas", thor::Resources::fromImage<sf::Texture>(atlasImage));
+		texture = &(*t_holder)["tankAtlas"];
+	}
+	CollisionDetector::loadMasks(texture, atlasImage, atlasFile);
+	return texture;
+}
+
+////////////////////////////////////////////////////////////
+void World::update(double dt, TankInput const & t_input)
+{
+	PROFILE_SCOPE(ProfileZone::TICK);
+
+	// Whatever happens this tick, render interpolates from where everything is now
+	m_tank.storePreviousState();
+	m_aiTank.storePreviousState();
+
+	if (m_aiTank.health() == 0)
+	{
+		// Collision detected, set game state to GAME_WIN
+		setGameState(GameState::GAME_WIN);
+
+	}
+	switch (m_currentGameState)
+	{
+	case GameState::GAME_RUNNING:
+		m_tank.update(dt, t_input);
+		if (t_input.isDown(TankInput::CENTRE_TURRET))
+		{
+			m_centringTurret = true;
+		}
+		if (m_centringTurret)
+		{
+			m_centringTurret = m_tank.centreTurret(dt);
+		}
+		m_aiTank.update(m_tank, dt);
+		updateBroadphase();
+
+		// Every system interested in this tick's hits reads them here, then they are dropped
+		m_aiTank.applyDamage(m_hits);
+		m_hits.clear();
+		break;
+
+	case GameState::GAME_WIN:
+		// Do nothing for now in the WIN state
+
+		break;
+
+	case GameState::GAME_LOSE:
+		// Do nothing for now in the LOSE state
+		break;
+
+	default:
+		break;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void World::snapshot(RenderSnapshot & t_snapshot) const
+{
+	m_tank.snapshot(t_snapshot.m_player);
+	m_aiTank.snapshot(t_snapshot.m_ai, t_snapshot.m_steering);
+	ProjectilePool const & shells = m_tank.getProjectiles();
+	shells.snapshot(t_snapshot.m_shells);
+	t_snapshot.m_shellTexture = shells.texture();
+	t_snapshot.m_gameState = m_currentGameState;
+	t_snapshot.m_aiHealth = m_aiTank.health();
+}
+
+////////////////////////////////////////////////////////////
+std::uint64_t World::stateHash() const
+{
+	StateHash hash;
+	hash.add(static_cast<int>(m_currentGameState));
+	hash.add(m_centringTurret);
+	m_tank.hash(hash);
+	m_aiTank.hash(hash);
+	return hash.value();
+}
+
+////////////////////////////////////////////////////////////
+GameState World::getGameState() const
+{
+	return m_currentGameState;
+}
+
+////////////////////////////////////////////////////////////
+std::vector<sf::Sprite> const & World::walls() const
+{
+	return m_wallSprites;
+}
+
+////////////////////////////////////////////////////////////
+sf::FloatRect World::bounds() const
+{
+	return m_bounds;
+}
+
+////////////////////////////////////////////////////////////
+void World::generateWalls()
+{
+	// Replace the ? With the actual values for the wall image
+	sf::IntRect wallRect(0,1501,30, 30);
+	// Create the Walls
+	for (auto const& obstacle : m_level.m_obstacles)
+	{
+		sf::Sprite sprite;
+		if (m_atlas != nullptr)
+		{
+			sprite.setTexture(*m_atlas);
+		}
+		sprite.setTextureRect(wallRect);
+		sprite.setOrigin(
+			wallRect.width / 2.0, wallRect.height / 2.0);
+		sprite.setPosition(obstacle.m_position);
+		sprite.setRotation(obstacle.m_rotation);
+		m_wallSprites.push_back(sprite);
+	}
+	m_wallGrid.build(m_wallSprites);
+}
+
+////////////////////////////////////////////////////////////
+void World::initBroadphase()
+{
+	m_playerBaseProxy = m_broadphase.createProxy(m_tank.getBase().getGlobalBounds(), s_PLAYER_GROUP, PLAYER_BASE, 0);
+	m_playerTurretProxy = m_broadphase.createProxy(m_tank.getTurret().getGlobalBounds(), s_PLAYER_GROUP, PLAYER_TURRET, 0);
+	m_aiBaseProxy = m_broadphase.createProxy(m_aiTank.getBase().getGlobalBounds(), s_AI_GROUP, AI_BASE, 0);
+	m_aiTurretProxy = m_broadphase.createProxy(m_aiTank.getTurret().getGlobalBounds(), s_AI_GROUP, AI_TURRET, 0);
+	m_shellProxies.assign(m_tank.getProjectiles().capacity(), -1);
+}
+
+////////////////////////////////////////////////////////////
+void World::updateBroadphase()
+{
+	PROFILE_SCOPE(ProfileZone::BROADPHASE);
+
+	m_broadphase.setBounds(m_playerBaseProxy, m_tank.getBase().getGlobalBounds());
+	m_broadphase.setBounds(m_playerTurretProxy, m_tank.getTurret().getGlobalBounds());
+	m_broadphase.setBounds(m_aiBaseProxy, m_aiTank.getBase().getGlobalBounds());
+	m_broadphase.setBounds(m_aiTurretProxy, m_aiTank.getTurret().getGlobalBounds());
+
+	ProjectilePool& shells = m_tank.getProjectiles();
+	if (static_cast<int>(m_shellProxies.size()) < shells.capacity())
+	{
+		// The pool grew
+		m_shellProxies.resize(shells.capacity(), -1);
+	}
+
+	// Drop the proxies of shells retired since the last tick
+	for (int i = 0; i < static_cast<int>(m_trackedShells.size());)
+	{
+		int slot = m_trackedShells[i];
+		if (shells.isActive(slot))
+		{
+			i++;
+			continue;
+		}
+		m_broadphase.destroyProxy(m_shellProxies[slot]);
+		m_shellProxies[slot] = -1;
+		m_trackedShells[i] = m_trackedShells.back();
+		m_trackedShells.pop_back();
+	}
+
+	for (int i = 0; i < shells.activeCount(); ++i)
+	{
+		int slot = shells.activeSlot(i);
+		int& proxy = m_shellProxies[slot];
+		if (proxy < 0)
+		{
+			proxy = m_broadphase.createProxy(shells.bounds(slot), s_PLAYER_GROUP, PLAYER_SHELL, slot);
+			m_trackedShells.push_back(slot);
+		}
+		else
+		{
+			m_broadphase.setBounds(proxy, shells.bounds(slot));
+		}
+	}
+
+	m_broadphase.update();
+
+	// The bounding boxes overlapping is all the narrowphase these responses need.
+	// Turret pairs are produced as well, but nothing responds to them yet.
+	for (SweepAndPrune::Pair const& pair : m_broadphase.pairs())
+	{
+		int first = m_broadphase.kind(pair.m_first);
+		int second = m_broadphase.kind(pair.m_second);
+
+		if (first == PLAYER_BASE && second == AI_BASE)
+		{
+			// Collision detected, set game state to GAME_LOSE
+			setGameState(GameState::GAME_LOSE);
+		}
+		else if (first == PLAYER_SHELL && second == AI_BASE)
+		{
+			int slot = m_broadphase.index(pair.m_first);
+			if (!shells.isActive(slot))
+			{
+				continue;
+			}
+			if (m_hits.push(HitEvent{ HitTarget::AI_TANK, shells.damage(), shells.position(slot) }))
+			{
+				shells.retire(slot);
+			}
+			else
+			{
+				// The queue is full this tick; the shell stays in flight and hits on the next one.
+				Logger::log(LogLevel::WARNING, LogCategory::COMBAT, "Hit queue full, shell {} deferred to the next tick", slot);
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void World::setGameState(GameState newState)
+{
+	m_currentGameState = newState;
+}
@@ -17,20 +17,148 @@
 #pragma comment(lib,"libyaml-cppmdd")
 #pragma comment(lib,"thor-d.lib")
 
+// A HEADLESS_ONLY build leaves out Game, and with it the window, fonts and textures, so it
+//  builds and runs on a machine without a display (see headless/Makefile).
+#ifndef HEADLESS_ONLY
 #include "Game.h"
+#endif // !HEADLESS_ONLY
+#include "HeadlessRunner.h"
+#include "Logger.h"
+#include "Profiler.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include <string>
 
 /// <summary>
 /// @brief starting point for all C++ programs.
 /// 
-/// Create a game object and run it.
+/// Create a game object and run it, or play matches headless.
+/// Options:
+///		--tick-rate N	run the simulation at N updates per second, 10 to 1000 (default 60)
+///		--headless		play matches without a window, as fast as possible
+///		--matches N		the number of headless matches to play (default 1)
+///		--max-ticks N	the most ticks a headless match may last (default 5 simulated minutes)
+///		--script FILE	the input script for headless matches (default resources/scripts/patrol.yaml)
+///		--record FILE	record the input and state hash of every tick (of the first match when headless)
+///		--replay FILE	play a recording back instead of reading input, reporting where it diverges;
+///						headless, exits with 1 if it diverged
+///		--trace FILE	on exit, write the most recent profiled events as Chrome trace JSON
 /// </summary>
-/// <param name=""></param>
+/// <param name="argc"></param>
 /// <param name="argv"></param>
 /// <returns></returns>
-int main(int, char* argv[])
+int main(int argc, char* argv[])
 {
-	Game game;
-	game.run();
+	double tickRate = World::s_DEFAULT_TICK_RATE;
+	bool headless = false;
+	int matches = 1;
+	int maxTicks = -1;
+	std::string scriptFile = "./resources/scripts/patrol.yaml";
+	std::string recordFile;
+	std::string replayFile;
+	std::string traceFile;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc)
+		{
+			tickRate = std::atof(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--headless") == 0)
+		{
+			headless = true;
+		}
+		else if (std::strcmp(argv[i], "--matches") == 0 && i + 1 < argc)
+		{
+			matches = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--max-ticks") == 0 && i + 1 < argc)
+		{
+			maxTicks = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--script") == 0 && i + 1 < argc)
+		{
+			scriptFile = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+		{
+			recordFile = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+		{
+			replayFile = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+		{
+			traceFile = argv[++i];
+		}
+	}
+
+	// A recording only replays exactly at the tick rate it was made at
+	InputRecording recording;
+	if (!replayFile.empty())
+	{
+		recording.load(replayFile);
+		tickRate = recording.tickRate();
+	}
+	if (!(tickRate >= World::s_MIN_TICK_RATE && tickRate <= World::s_MAX_TICK_RATE))
+	{
+		std::cout << "The tick rate must be between " << World::s_MIN_TICK_RATE << " and "
+			<< World::s_MAX_TICK_RATE << " updates per second, got " << tickRate << std::endl;
+		return 1;
+	}
+	if (maxTicks <= 0)
+	{
+		maxTicks = static_cast<int>(tickRate * 300.0);
+	}
+
+	int result = 0;
+	Logger::start();
+	if (headless)
+	{
+		InputScript script;
+		script.load(scriptFile);
+		HeadlessRunner runner(script, tickRate, maxTicks);
+		if (!replayFile.empty())
+		{
+			result = runner.replay(recording) ? 0 : 1;
+		}
+		else
+		{
+			if (!recordFile.empty())
+			{
+				runner.recordTo(recordFile);
+			}
+			runner.run(std::max(matches, 1));
+		}
+	}
+	else
+	{
+#ifdef HEADLESS_ONLY
+		std::cout << "This build only plays headless matches, run it with --headless" << std::endl;
+		result = 1;
+#else
+		Game game(tickRate);
+		if (!replayFile.empty())
+		{
+			game.replay(recording);
+		}
+		else if (!recordFile.empty())
+		{
+			game.recordTo(recordFile);
+		}
+		game.run();
+#endif // HEADLESS_ONLY
+	}
+	Logger::stop();
+
+	// Every profiled thread has finished by now
+	if (!traceFile.empty() && !Profiler::writeChromeTrace(traceFile))
+	{
+		std::cout << "Could not write trace " << traceFile << std::endl;
+	}
+	return result;
 }
 
 // Comment
\ No newline at end of file